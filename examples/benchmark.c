@@ -0,0 +1,501 @@
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <pico/stdlib.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+#include "ssd1306_gray.h"
+#include "ssd1306_dither.h"
+#include "ssd1306_recorder.h"
+#include "raspberry26x32.h"
+#include "ssd1306_font.h"
+
+
+#define BENCH_PIXEL_COUNT           100000
+#define BENCH_LINE_COUNT            2000
+#define BENCH_GLYPH_COUNT           20000
+#define BENCH_BLIT_COUNT            5000
+#define BENCH_SHAPE_COUNT           2000
+#define BENCH_FRAME_COUNT           200
+#define BENCH_SUBFRAME_COUNT        600
+#define BENCH_IMAGE_COUNT           100
+#define BENCH_SPI_CLK_FREQ_KHZ      10000
+#define BENCH_RECORD_BUFF_SIZE      2048
+
+
+typedef struct bench_workload_t {
+    const char* name;
+    void (*draw_frame)(ssd1306_canvas_t* canvas, uint frame_idx);
+}
+bench_workload_t;
+
+typedef struct bench_shape_t {
+    const char* name;
+    void (*draw_shape)(ssd1306_canvas_t* canvas, uint shape_idx);
+}
+bench_shape_t;
+
+
+ssd1306_err_t null_transport_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count);
+size_t get_font_idx(uint8_t character);
+uint64_t model_spi_time_us(const ssd1306_stats_t* stats, uint freq_khz);
+void print_hist(const char* name, const uint32_t hist[], bool is_last);
+void bench_primitives();
+void bench_workloads();
+void bench_grayscale();
+void bench_dither();
+void bench_command_stream();
+void draw_full_redraw(ssd1306_canvas_t* canvas, uint frame_idx);
+void draw_ticking_counter(ssd1306_canvas_t* canvas, uint frame_idx);
+void draw_scrolling_log(ssd1306_canvas_t* canvas, uint frame_idx);
+void draw_sprite_motion(ssd1306_canvas_t* canvas, uint frame_idx);
+void draw_shape_fill_rect(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_fill_round_rect(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_draw_round_rect(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_fill_circle(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_draw_circle(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_fill_triangle(ssd1306_canvas_t* canvas, uint shape_idx);
+void draw_shape_draw_polyline(ssd1306_canvas_t* canvas, uint shape_idx);
+
+
+static uint8_t ram_buffer[SSD1306_PREFIXED_FRAME_SIZE];
+static ssd1306_canvas_t canvas;
+static uint8_t gray_planes[SSD1306_GRAY_PLANES_SIZE];
+static uint8_t rowmajor_bitmap[32 / 8 * 32];
+static uint8_t gray_image[SSD1306_WIDTH * SSD1306_HEIGHT];
+static int16_t dither_errors[SSD1306_DITHER_ERROR_BUFF_LEN(SSD1306_WIDTH)];
+static uint8_t record_buffer[BENCH_RECORD_BUFF_SIZE];
+static const ssd1306_font_t font_8x8 = {
+    .glyphs = font,
+    .glyph_width = 8,
+    .get_glyph_idx = get_font_idx,
+};
+
+static const bench_workload_t workloads[] = {
+    { "full_redraw",        draw_full_redraw },
+    { "ticking_counter",    draw_ticking_counter },
+    { "scrolling_log",      draw_scrolling_log },
+    { "sprite_motion",      draw_sprite_motion },
+};
+
+static const bench_shape_t shapes[] = {
+    { "fill_rect",          draw_shape_fill_rect },
+    { "fill_round_rect",    draw_shape_fill_round_rect },
+    { "draw_round_rect",    draw_shape_draw_round_rect },
+    { "fill_circle",        draw_shape_fill_circle },
+    { "draw_circle",        draw_shape_draw_circle },
+    { "fill_triangle",      draw_shape_fill_triangle },
+    { "draw_polyline",      draw_shape_draw_polyline },
+};
+
+
+ssd1306_err_t null_transport_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count)
+{
+    // Bytes are only counted by the driver statistics
+    return SSD1306_ERR_OK;
+}
+
+size_t get_font_idx(uint8_t character)
+{
+    if (isalpha(character))
+    {
+        return toupper(character) - 'A' + 1;
+    }
+    else
+    if (isdigit(character))
+    {
+        return  character - '0' + 27;
+    }
+    else
+    {
+        return  0;
+    }
+}
+
+uint64_t model_spi_time_us(const ssd1306_stats_t* stats, uint freq_khz)
+{
+    // 4-wire SPI has no address and selects commands or data with the D/C pin instead of a control byte
+    uint64_t clocks = (uint64_t)(stats->bytes - stats->transactions) * 8;
+
+    return clocks * 1000 / freq_khz;
+}
+
+void print_hist(const char* name, const uint32_t hist[], bool is_last)
+{
+    printf("      \"%s\": [", name);
+
+    for(uint i = 0; i < SSD1306_TIME_HIST_BUCKET_COUNT; ++i)
+    {
+        printf("%lu%s", (unsigned long)hist[i], i + 1 < SSD1306_TIME_HIST_BUCKET_COUNT ? ", " : "");
+    }
+
+    printf("]%s\n", is_last ? "" : ",");
+}
+
+void bench_primitives()
+{
+    ssd1306_gfx_clear(&canvas, false);
+
+    uint64_t start_us = time_us_64();
+
+    for(uint i = 0; i < BENCH_PIXEL_COUNT; ++i)
+    {
+        ssd1306_gfx_set_pixel(&canvas, (i * 7) % SSD1306_WIDTH, (i * 13) % SSD1306_HEIGHT, i & 1);
+    }
+
+    uint64_t pixel_us = time_us_64() - start_us;
+    uint64_t line_pixels = 0;
+
+    start_us = time_us_64();
+
+    for(uint i = 0; i < BENCH_LINE_COUNT; ++i)
+    {
+        int x0 = (i * 17) % SSD1306_WIDTH;
+        int y0 = (i * 5) % SSD1306_HEIGHT;
+        int x1 = SSD1306_WIDTH - 1 - x0;
+        int y1 = SSD1306_HEIGHT - 1 - y0;
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+
+        ssd1306_gfx_draw_line(&canvas, x0, y0, x1, y1, i & 1);
+        line_pixels += (dx > dy ? dx : dy) + 1;
+    }
+
+    uint64_t line_us = time_us_64() - start_us;
+
+    start_us = time_us_64();
+
+    for(uint i = 0; i < BENCH_GLYPH_COUNT; ++i)
+    {
+        ssd1306_gfx_draw_char(&canvas, (i * 8) % (SSD1306_WIDTH - 8), (i * 3) % (SSD1306_HEIGHT - 8), &font_8x8, 'A' + i % 26);
+    }
+
+    uint64_t glyph_us = time_us_64() - start_us;
+
+    for(size_t i = 0; i < sizeof(rowmajor_bitmap); ++i)
+    {
+        rowmajor_bitmap[i] = i * 37;
+    }
+
+    start_us = time_us_64();
+
+    for(uint i = 0; i < BENCH_BLIT_COUNT; ++i)
+    {
+        ssd1306_gfx_blit_rowmajor(&canvas, (i * 11) % (SSD1306_WIDTH - 32), (i * 7) % (SSD1306_HEIGHT - 32), rowmajor_bitmap, 32, 32);
+    }
+
+    uint64_t blit_us = time_us_64() - start_us;
+    uint64_t shape_us[count_of(shapes)];
+
+    for(size_t s = 0; s < count_of(shapes); ++s)
+    {
+        start_us = time_us_64();
+
+        for(uint i = 0; i < BENCH_SHAPE_COUNT; ++i)
+        {
+            shapes[s].draw_shape(&canvas, i);
+        }
+
+        shape_us[s] = time_us_64() - start_us;
+    }
+
+    printf("  \"primitives\": {\n");
+    printf("    \"set_pixel_pixels_per_s\": %llu,\n", (unsigned long long)(BENCH_PIXEL_COUNT * 1000000ULL / (pixel_us + 1)));
+    printf("    \"draw_line_pixels_per_s\": %llu,\n", (unsigned long long)(line_pixels * 1000000ULL / (line_us + 1)));
+    printf("    \"draw_char_glyphs_per_s\": %llu,\n", (unsigned long long)(BENCH_GLYPH_COUNT * 1000000ULL / (glyph_us + 1)));
+    printf("    \"blit_rowmajor_pixels_per_s\": %llu,\n", (unsigned long long)(BENCH_BLIT_COUNT * 32ULL * 32 * 1000000ULL / (blit_us + 1)));
+
+    for(size_t s = 0; s < count_of(shapes); ++s)
+    {
+        printf("    \"%s_shapes_per_s\": %llu%s\n", shapes[s].name,
+            (unsigned long long)(BENCH_SHAPE_COUNT * 1000000ULL / (shape_us[s] + 1)),
+            s + 1 < count_of(shapes) ? "," : "");
+    }
+
+    printf("  },\n");
+}
+
+void draw_shape_fill_rect(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_gfx_fill_rect(canvas, shape_idx % 28, (shape_idx * 3) % 24, 100, 40, shape_idx & 1);
+}
+
+void draw_shape_fill_round_rect(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_gfx_fill_round_rect(canvas, shape_idx % 28, (shape_idx * 3) % 24, 100, 40, 8, shape_idx & 1);
+}
+
+void draw_shape_draw_round_rect(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_gfx_draw_round_rect(canvas, shape_idx % 28, (shape_idx * 3) % 24, 100, 40, 8, shape_idx & 1);
+}
+
+void draw_shape_fill_circle(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_gfx_fill_circle(canvas, 20 + (shape_idx * 7) % 88, 20 + (shape_idx * 3) % 24, 20, shape_idx & 1);
+}
+
+void draw_shape_draw_circle(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_gfx_draw_circle(canvas, 20 + (shape_idx * 7) % 88, 20 + (shape_idx * 3) % 24, 20, shape_idx & 1);
+}
+
+void draw_shape_fill_triangle(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    int x = (shape_idx * 7) % 64;
+
+    ssd1306_gfx_fill_triangle(canvas, x, 0, x + 63, 20, x + 16, SSD1306_HEIGHT - 1, shape_idx & 1);
+}
+
+void draw_shape_draw_polyline(ssd1306_canvas_t* canvas, uint shape_idx)
+{
+    ssd1306_point_t points[9];
+
+    // Zigzag across the display, one segment every 16 columns
+    for(size_t i = 0; i < count_of(points); ++i)
+    {
+        points[i].x = i * 16 - (i == count_of(points) - 1);
+        points[i].y = (i + shape_idx) & 1 ? SSD1306_HEIGHT - 1 : 0;
+    }
+
+    ssd1306_gfx_draw_polyline(canvas, points, count_of(points), shape_idx & 1);
+}
+
+void draw_full_redraw(ssd1306_canvas_t* canvas, uint frame_idx)
+{
+    ssd1306_gfx_clear(canvas, false);
+
+    for(int x = 0; x < SSD1306_WIDTH; x += 4)
+    {
+        ssd1306_gfx_draw_line(canvas, x, 0, SSD1306_WIDTH - 1 - x, SSD1306_HEIGHT - 1, true);
+    }
+
+    // Every frame differs from the previous one in every page
+    if(frame_idx & 1)
+    {
+        for(size_t i = 0; i < SSD1306_RAM_BUFF_SIZE; ++i)
+        {
+            canvas->buffer[i] = ~canvas->buffer[i];
+        }
+    }
+}
+
+void draw_ticking_counter(ssd1306_canvas_t* canvas, uint frame_idx)
+{
+    char text[8];
+    snprintf(text, sizeof(text), "%05u", frame_idx);
+
+    ssd1306_gfx_fill_rect(canvas, 44, 24, 40, 8, false);
+    ssd1306_gfx_draw_str(canvas, 44, 24, &font_8x8, text);
+}
+
+void draw_scrolling_log(ssd1306_canvas_t* canvas, uint frame_idx)
+{
+    char text[17];
+    snprintf(text, sizeof(text), "LOG LINE %u", frame_idx);
+
+    memmove(canvas->buffer, canvas->buffer + SSD1306_WIDTH, SSD1306_RAM_BUFF_SIZE - SSD1306_WIDTH);
+    ssd1306_gfx_fill_rect(canvas, 0, SSD1306_HEIGHT - 8, SSD1306_WIDTH, 8, false);
+    ssd1306_gfx_draw_str(canvas, 0, SSD1306_HEIGHT - 8, &font_8x8, text);
+}
+
+void draw_sprite_motion(ssd1306_canvas_t* canvas, uint frame_idx)
+{
+    int span = SSD1306_WIDTH - IMG_WIDTH;
+    int x = frame_idx % span;
+    int y = (frame_idx * 3) % (SSD1306_HEIGHT - IMG_HEIGHT);
+
+    ssd1306_gfx_clear(canvas, false);
+    ssd1306_gfx_draw_bitmap(canvas, x, y, raspberry26x32, IMG_WIDTH, IMG_HEIGHT);
+}
+
+void bench_workloads()
+{
+    printf("  \"workloads\": [\n");
+
+    for(size_t w = 0; w < count_of(workloads); ++w)
+    {
+        ssd1306_gfx_clear(&canvas, false);
+        ssd1306_invalidate_ram();
+        ssd1306_flush_prefixed(ram_buffer);
+        ssd1306_reset_stats();
+
+        uint64_t start_us = time_us_64();
+
+        for(uint frame = 0; frame < BENCH_FRAME_COUNT; ++frame)
+        {
+            workloads[w].draw_frame(&canvas, frame);
+            ssd1306_flush_prefixed(ram_buffer);
+        }
+
+        uint64_t cpu_us = time_us_64() - start_us;
+
+        ssd1306_stats_t stats;
+        ssd1306_get_stats(&stats);
+
+        printf("    {\n");
+        printf("      \"name\": \"%s\",\n", workloads[w].name);
+        printf("      \"frames\": %u,\n", BENCH_FRAME_COUNT);
+        printf("      \"cpu_us_per_frame\": %llu,\n", (unsigned long long)(cpu_us / BENCH_FRAME_COUNT));
+        printf("      \"bytes_per_frame\": %lu,\n", (unsigned long)(stats.bytes / BENCH_FRAME_COUNT));
+        printf("      \"transactions_per_frame\": %lu,\n", (unsigned long)(stats.transactions / BENCH_FRAME_COUNT));
+        printf("      \"wire_us_per_frame\": {\n");
+        printf("        \"i2c_400khz\": %llu,\n", (unsigned long long)(ssd1306_model_i2c_time_ns(&stats, 400) / 1000 / BENCH_FRAME_COUNT));
+        printf("        \"i2c_1mhz\": %llu,\n", (unsigned long long)(ssd1306_model_i2c_time_ns(&stats, 1000) / 1000 / BENCH_FRAME_COUNT));
+        printf("        \"spi_10mhz\": %llu\n", (unsigned long long)(model_spi_time_us(&stats, BENCH_SPI_CLK_FREQ_KHZ) / BENCH_FRAME_COUNT));
+        printf("      },\n");
+        print_hist("cmd_wire_us_hist_400khz", stats.cmd_wire_time_hist, false);
+        print_hist("data_wire_us_hist_400khz", stats.data_wire_time_hist, true);
+        printf("    }%s\n", w + 1 < count_of(workloads) ? "," : "");
+    }
+
+    printf("  ],\n");
+}
+
+void bench_grayscale()
+{
+    ssd1306_gray_t gray;
+    ssd1306_gray_init(&gray, gray_planes, ram_buffer);
+
+    // Gauge bars of every level over a level 0 background, the rest of the display stays static
+    for(uint8_t level = 1; level < SSD1306_GRAY_LEVEL_COUNT; ++level)
+    {
+        ssd1306_gray_fill_rect(&gray, 8, 8 + (level - 1) * 16, SSD1306_WIDTH - 16, 12, level);
+    }
+
+    ssd1306_invalidate_ram();
+    ssd1306_reset_stats();
+
+    uint64_t start_us = time_us_64();
+
+    for(uint i = 0; i < BENCH_SUBFRAME_COUNT; ++i)
+    {
+        ssd1306_gray_flush_next(&gray);
+    }
+
+    uint64_t cpu_us = time_us_64() - start_us;
+
+    ssd1306_stats_t stats;
+    ssd1306_get_stats(&stats);
+
+    uint64_t wire_400khz_ns = ssd1306_model_i2c_time_ns(&stats, 400);
+    uint64_t wire_1mhz_ns = ssd1306_model_i2c_time_ns(&stats, 1000);
+
+    printf("  \"grayscale\": {\n");
+    printf("    \"subframes\": %u,\n", BENCH_SUBFRAME_COUNT);
+    printf("    \"cpu_subframes_per_s\": %llu,\n", (unsigned long long)(BENCH_SUBFRAME_COUNT * 1000000ULL / (cpu_us + 1)));
+    printf("    \"bytes_per_subframe\": %lu,\n", (unsigned long)(stats.bytes / BENCH_SUBFRAME_COUNT));
+    printf("    \"wire_subframes_per_s\": {\n");
+    printf("      \"i2c_400khz\": %llu,\n", (unsigned long long)(BENCH_SUBFRAME_COUNT * 1000000000ULL / (wire_400khz_ns + 1)));
+    printf("      \"i2c_1mhz\": %llu\n", (unsigned long long)(BENCH_SUBFRAME_COUNT * 1000000000ULL / (wire_1mhz_ns + 1)));
+    printf("    }\n");
+    printf("  },\n");
+}
+
+void bench_dither()
+{
+    static const char* mode_names[SSD1306_DITHER_MODE_COUNT] = {
+        "threshold",
+        "bayer",
+        "floyd_steinberg",
+    };
+
+    // Radial gradient, every gray level occurs
+    for(int y = 0; y < SSD1306_HEIGHT; ++y)
+    {
+        for(int x = 0; x < SSD1306_WIDTH; ++x)
+        {
+            int dx = x - SSD1306_WIDTH / 2;
+            int dy = 2 * (y - SSD1306_HEIGHT / 2);
+            int dist = (dx * dx + dy * dy) / 16;
+
+            gray_image[y * SSD1306_WIDTH + x] = dist < 0xFF ? 0xFF - dist : 0;
+        }
+    }
+
+    printf("  \"dither_images_per_s\": {\n");
+
+    for(uint mode = 0; mode < SSD1306_DITHER_MODE_COUNT; ++mode)
+    {
+        uint64_t start_us = time_us_64();
+
+        for(uint i = 0; i < BENCH_IMAGE_COUNT; ++i)
+        {
+            ssd1306_dither_image(
+                &canvas, 0, 0,
+                gray_image, SSD1306_WIDTH, SSD1306_HEIGHT,
+                mode, dither_errors, count_of(dither_errors)
+            );
+        }
+
+        uint64_t image_us = time_us_64() - start_us;
+
+        printf("    \"%s\": %llu%s\n",
+            mode_names[mode],
+            (unsigned long long)(BENCH_IMAGE_COUNT * 1000000ULL / (image_us + 1)),
+            mode + 1 < SSD1306_DITHER_MODE_COUNT ? "," : ""
+        );
+    }
+
+    printf("  },\n");
+}
+
+void bench_command_stream()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_recorder_t recorder;
+
+    // Log of initialization and one full frame, decode with xxd -r -p and replay with tools/ssd1306_replay.c
+    ssd1306_deinit_i2c();
+    ssd1306_recorder_init(&recorder, record_buffer, sizeof(record_buffer), null_transport_writev, NULL);
+    ssd1306_init_transport_v(ssd1306_recorder_writev, &recorder);
+    ssd1306_init_display(&config);
+    ssd1306_set_flush_hook(ssd1306_recorder_mark_frame, &recorder);
+
+    draw_full_redraw(&canvas, 0);
+    ssd1306_flush_prefixed(ram_buffer);
+
+    printf("  \"command_stream\": {\n");
+    printf("    \"log_bytes\": %lu,\n", (unsigned long)recorder.used);
+    printf("    \"dropped_transactions\": %lu,\n", (unsigned long)recorder.dropped);
+    printf("    \"log_hex\": \"");
+
+    for(size_t i = 0; i < recorder.used; ++i)
+    {
+        printf("%02x", record_buffer[i]);
+    }
+
+    printf("\"\n");
+    printf("  }\n");
+}
+
+
+int main()
+{
+    stdio_init_all();
+
+    ssd1306_canvas_init(&canvas, ram_buffer + SSD1306_PREFIX_SIZE, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_init_transport_v(null_transport_writev, NULL);
+    ssd1306_set_i2c_clk_freq(400);
+
+    printf("{\n");
+    bench_primitives();
+    bench_workloads();
+    bench_grayscale();
+    bench_dither();
+    bench_command_stream();
+    printf("}\n");
+
+    ssd1306_deinit_i2c();
+
+#if PICO_ON_DEVICE
+    // Keeps the results on the console until the board is reset, host builds exit instead
+    while(true)
+    {
+        sleep_ms(1000);
+    }
+#endif
+
+    return 0;
+}
@@ -9,6 +9,8 @@
 #include <hardware/i2c.h>
 
 #include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+#include "ssd1306_asset.h"
 #include "raspberry26x32.h"
 #include "ssd1306_font.h"
 
@@ -27,56 +29,21 @@ typedef struct point_t {
 } 
 point_t;
 
-typedef struct render_area_t {
-    uint8_t start_col;
-    uint8_t end_col;
-    uint8_t start_page;
-    uint8_t end_page;
-    size_t ram_buffer_len;
-} 
-render_area_t;
 
 
 void init_display();
 bool init_all();
-void render(uint8_t* ram_buffer, render_area_t* render_area);
-void set_pixel(uint8_t* ram_buffer, size_t x, size_t y, bool is_on);
-void draw_line(uint8_t* ram_buffer, int x0, int y0, int x1, int y1, bool is_on);
 size_t get_font_idx(uint8_t character); 
-void write_char(uint8_t* ram_buffer, size_t x, size_t y, uint8_t character);
-void write_str(uint8_t* ram_buffer, size_t x, size_t y, char* str);
 
 
 void init_display()
 {
-    // set display off
-    ssd1306_power_off();
-
-    // memory mapping
-    ssd1306_set_mem_mode_horizontal();
-
-    // resolution and layout
-    ssd1306_set_display_start_line(0);
-    ssd1306_seg_remap_on();
-    ssd1306_set_mux_ratio(SSD1306_HEIGHT - 1);
-    ssd1306_com_out_scan_remap_on();
-    ssd1306_set_display_offset(0);
-    ssd1306_set_com_pin_config_alt_remap_off();
-
-    // timing and driving scheme
-    ssd1306_set_dclk_div_and_osc_freq(SSD1306_DEFAULT_DCLK_DIV_RATIO, SSD1306_DEFAULT_OSC_FREQ_LEVEL);
-    ssd1306_set_precharge_period(1, 15);
-    ssd1306_set_vcomh_deselect_level(SSD1306_VCOMH_DESELECT_LVL_0_83);
-
-    // display
-    ssd1306_set_contrast(0xFF);
-    ssd1306_follow_ram();
-    ssd1306_inversion_off();
-    ssd1306_charge_pump_on();
-    ssd1306_scroll_off();
-
-    // set display on
-    ssd1306_power_on();
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+
+    if(ssd1306_init_display(&config) != SSD1306_ERR_OK)
+    {
+        printf("Display init failed\n");
+    }
 }
 
 bool init_all()
@@ -96,73 +63,14 @@ bool init_all()
     bi_decl(bi_2pins_with_func(SSD1306_I2C_SDA_PIN, SSD1306_I2C_SCL_PIN, GPIO_FUNC_I2C));
     ssd1306_init_i2c(SSD1306_I2C_INSTANCE, SSD1306_I2C_SDA_PIN, SSD1306_I2C_SCL_PIN);
 
-    init_display();
-
-    return true;
-}
-
-void render(uint8_t* ram_buffer, render_area_t* render_area) 
-{
-    ssd1306_set_col_address(render_area->start_col, render_area->end_col);
-    ssd1306_set_page_address(render_area->start_page, render_area->end_page);
-
-    ssd1306_send_data(ram_buffer, render_area->ram_buffer_len);
-}
-
-void set_pixel(uint8_t* ram_buffer, size_t x, size_t y, bool is_on) 
-{
-    assert(x >= 0 && x < SSD1306_WIDTH && y >=0 && y < SSD1306_HEIGHT);
-
-    size_t bytes_per_row = (SSD1306_WIDTH * SSD1306_PAGE_HEIGHT) / 8;
-    size_t byte_idx = (y / 8) * bytes_per_row + x;
-    size_t bit_no = y % 8;
-    
-    uint8_t byte = ram_buffer[byte_idx];
-
-    if(is_on)
-    {
-        byte |=  1 << bit_no;
-    }
-    else
+    if(ssd1306_calibrate_i2c_clk(SSD1306_I2C_MAX_CLK_FREQ_KHZ) != SSD1306_ERR_OK)
     {
-        byte &= ~(1 << bit_no);
+        printf("I2C clock calibration failed\n");
     }
 
-    ram_buffer[byte_idx] = byte;
-}
-
-void draw_line(uint8_t* ram_buffer, int x0, int y0, int x1, int y1, bool is_on) 
-{
-
-    int dx =  abs(x1-x0);
-    int sx = x0<x1 ? 1 : -1;
-    int dy = -abs(y1-y0);
-    int sy = y0<y1 ? 1 : -1;
-    int err = dx+dy;
-    int e2;
-
-    while (true) 
-    {
-        set_pixel(ram_buffer, x0, y0, is_on);
-
-        if (x0 == x1 && y0 == y1)
-        {
-            break;
-        }
-        
-        e2 = 2 * err;
+    init_display();
 
-        if (e2 >= dy) 
-        {
-            err += dy;
-            x0 += sx;
-        }
-        if (e2 <= dx) 
-        {
-            err += dx;
-            y0 += sy;
-        }
-    }
+    return true;
 }
 
 size_t get_font_idx(uint8_t character) 
@@ -182,42 +90,6 @@ size_t get_font_idx(uint8_t character)
     }
 }
 
-void write_char(uint8_t* ram_buffer, size_t x, size_t y, uint8_t character) 
-{
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8)
-    {
-        return;
-    }
-
-    // For the moment, only write on Y row boundaries (every 8 vertical pixels)
-    
-    y /= 8;
-
-    size_t font_idx = get_font_idx(character);
-    size_t ram_buffer_idx = y * 128 + x;
-
-    for (size_t i = 0; i < 8; ++i) 
-    {
-        ram_buffer[ram_buffer_idx++] = font[font_idx * 8 + i];
-    }
-}
-
-void write_str(uint8_t* ram_buffer, size_t x, size_t y, char* str) 
-{
-    // Cull out any string off the screen
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8)
-    {
-        return;
-    }
-
-    for(size_t i = 0; str[i] != 0; ++i)
-    {
-        write_char(ram_buffer, x, y, str[i]);
-        x += SSD1306_PAGE_HEIGHT;
-    }
-}
-
-
 int main() 
 {   
     if(!init_all())
@@ -225,16 +97,19 @@ int main()
         return -1;
     }
 
-    render_area_t frame_area;
-    frame_area.start_col = 0;    
-    frame_area.end_col = SSD1306_WIDTH - 1;
-    frame_area.start_page = 0;    
-    frame_area.end_page = SSD1306_PAGE_COUNT - 1;
-    frame_area.ram_buffer_len = SSD1306_RAM_BUFF_SIZE;
+    // Control byte slot in front of the frame lets flushes skip copying it
+    uint8_t ram_buffer[SSD1306_PREFIXED_FRAME_SIZE];
+    memset(ram_buffer, 0, SSD1306_PREFIXED_FRAME_SIZE);
 
-    uint8_t ram_buffer[SSD1306_RAM_BUFF_SIZE];
-    memset(ram_buffer, 0, SSD1306_RAM_BUFF_SIZE);
-    render(ram_buffer, &frame_area);
+    ssd1306_canvas_t canvas;
+    ssd1306_canvas_init(&canvas, ram_buffer + SSD1306_PREFIX_SIZE, SSD1306_WIDTH, SSD1306_HEIGHT);
+
+    const ssd1306_font_t font_8x8 = {
+        .glyphs = font,
+        .glyph_width = 8,
+        .get_glyph_idx = get_font_idx,
+    };
+    ssd1306_flush_prefixed(ram_buffer);
 
     for (int i = 0; i < 3; ++i) 
     {
@@ -245,23 +120,20 @@ int main()
         sleep_ms(500);
     }
 
-    render_area_t picure_area;
-    picure_area.start_page = 0;
-    picure_area.end_page = (IMG_HEIGHT / SSD1306_PAGE_HEIGHT) - 1;    
+    // Streamed to the display straight from flash
+    const ssd1306_asset_t picture = {
+        .data = raspberry26x32,
+        .width = IMG_WIDTH,
+        .height = IMG_HEIGHT,
+    };
 
 
     while (true) 
     {
-        picure_area.start_col = 0;
-        picure_area.end_col = IMG_WIDTH - 1;
-        picure_area.ram_buffer_len = IMG_WIDTH * (IMG_HEIGHT / SSD1306_PAGE_HEIGHT);
-
         uint8_t picture_offset = 5 + IMG_WIDTH;
         for (int i = 0; i < 3; ++i) 
         {
-            render(raspberry26x32, &picure_area);
-            picure_area.start_col += picture_offset;
-            picure_area.end_col += picture_offset;
+            ssd1306_asset_stream(&picture, i * picture_offset, 0);
         }
         
         ssd1306_h_scroll_right_setup(0, 3, SSD1306_SCROLL_FREQ_5);
@@ -283,10 +155,10 @@ int main()
         size_t y = 0;
         for (size_t i = 0; i < count_of(text); ++i) 
         {
-            write_str(ram_buffer, 5, y, text[i]);
+            ssd1306_gfx_draw_str(&canvas, 5, y, &font_8x8, text[i]);
             y+=8;
         }
-        render(ram_buffer, &frame_area);
+        ssd1306_flush_prefixed(ram_buffer);
 
 
         sleep_ms(3000);
@@ -301,14 +173,14 @@ int main()
         {
             for (size_t x = 0; x < SSD1306_WIDTH; ++x) 
             {
-                draw_line(ram_buffer, x, 0, SSD1306_WIDTH - 1 - x, SSD1306_HEIGHT - 1, pixel_value);
-                render(ram_buffer, &frame_area);
+                ssd1306_gfx_draw_line(&canvas, x, 0, SSD1306_WIDTH - 1 - x, SSD1306_HEIGHT - 1, pixel_value);
+                ssd1306_flush_paced(ram_buffer);
             }
 
             for (int y = SSD1306_HEIGHT - 1; y >= 0; --y) 
             {
-                draw_line(ram_buffer, 0, y, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1 - y, pixel_value);
-                render(ram_buffer, &frame_area);
+                ssd1306_gfx_draw_line(&canvas, 0, y, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1 - y, pixel_value);
+                ssd1306_flush_paced(ram_buffer);
             }
 
             pixel_value = false;
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <pico/stdlib.h>
+#include <pico/cyw43_arch.h>
+#include <pico/binary_info.h>
+#include <hardware/gpio.h>
+#include <hardware/i2c.h>
+#include <lwip/netif.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_net.h"
+
+
+#define SSD1306_I2C_INSTANCE        i2c0
+#define SSD1306_I2C_SDA_PIN         16
+#define SSD1306_I2C_SCL_PIN         17
+#define WIFI_CONNECT_TIMEOUT_MS     30000
+
+
+bool init_all();
+
+
+static uint8_t ram_buffer[SSD1306_RAM_BUFF_SIZE];
+static ssd1306_net_server_t server;
+
+
+bool init_all()
+{
+    if(!stdio_init_all())
+    {
+        printf("stdio init failed\n");
+        return false;
+    }
+
+    if (cyw43_arch_init() != PICO_OK) 
+    {
+        printf("CYW43 arch init failed\n");
+        return false;
+    }
+
+    bi_decl(bi_2pins_with_func(SSD1306_I2C_SDA_PIN, SSD1306_I2C_SCL_PIN, GPIO_FUNC_I2C));
+    ssd1306_init_i2c(SSD1306_I2C_INSTANCE, SSD1306_I2C_SDA_PIN, SSD1306_I2C_SCL_PIN);
+
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+
+    if(ssd1306_init_display(&config) != SSD1306_ERR_OK)
+    {
+        printf("Display init failed\n");
+        return false;
+    }
+
+    cyw43_arch_enable_sta_mode();
+
+    if(cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, WIFI_CONNECT_TIMEOUT_MS) != 0)
+    {
+        printf("Wi-Fi connection failed\n");
+        return false;
+    }
+
+    return true;
+}
+
+int main()
+{
+    if(!init_all())
+    {
+        return -1;
+    }
+
+    ssd1306_flush(ram_buffer);
+    ssd1306_net_server_init(&server, ram_buffer, NULL, NULL);
+
+    if(ssd1306_net_server_start(&server, SSD1306_NET_DEFAULT_PORT) != SSD1306_ERR_OK)
+    {
+        printf("Display server start failed\n");
+        return -1;
+    }
+
+    printf("Display server listening on %s:%u\n", ip4addr_ntoa(netif_ip4_addr(netif_list)), SSD1306_NET_DEFAULT_PORT);
+
+    while(true)
+    {
+        // Packets are received and sent to the display from here
+        cyw43_arch_poll();
+        cyw43_arch_wait_for_work_until(make_timeout_time_ms(1000));
+    }
+
+    return 0;
+}
@@ -9,7 +9,7 @@
 
 #include <stdint.h>
 
-static uint8_t font[] = {
+static const uint8_t font[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     //Space 
     0xf0, 0x28, 0x24, 0x22, 0x24, 0x28, 0xf0, 0x00,     //A
     0xfe, 0x92, 0x92, 0x92, 0x92, 0x92, 0x6c, 0x00,     //B
@@ -0,0 +1,33 @@
+/**
+ *
+ *  @file
+ *  @brief Host shim of the Pico SDK GPIO API, pin functions are accepted and ignored
+ *
+ **/
+
+#ifndef HARDWARE_GPIO_H
+#define HARDWARE_GPIO_H
+
+#include <pico/stdlib.h>
+
+#define GPIO_FUNC_I2C   3
+
+
+static inline void gpio_set_function(uint gpio, uint fn)
+{
+    (void)gpio;
+    (void)fn;
+}
+
+static inline void gpio_pull_up(uint gpio)
+{
+    (void)gpio;
+}
+
+static inline void gpio_deinit(uint gpio)
+{
+    (void)gpio;
+}
+
+
+#endif //HARDWARE_GPIO_H
@@ -0,0 +1,70 @@
+/**
+ *
+ *  @file
+ *  @brief Host shim of the Pico SDK I2C API
+ *
+ *  There is no bus on the host: writes fail and the register block reports an abort,
+ *  so tests and benchmarks register a transport instead.
+ *
+ **/
+
+#ifndef HARDWARE_I2C_H
+#define HARDWARE_I2C_H
+
+#include <pico/stdlib.h>
+
+#define I2C_IC_DATA_CMD_STOP_BITS           _u(0x00000200)
+#define I2C_IC_DATA_CMD_RESTART_BITS        _u(0x00000400)
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS   _u(0x00000040)
+#define I2C_IC_RAW_INTR_STAT_STOP_DET_BITS  _u(0x00000200)
+#define I2C_IC_STATUS_TFE_BITS              _u(0x00000004)
+#define I2C_IC_STATUS_ACTIVITY_BITS         _u(0x00000001)
+
+
+typedef struct i2c_hw_t
+{
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t raw_intr_stat;
+    volatile uint32_t clr_tx_abrt;
+    volatile uint32_t clr_stop_det;
+    volatile uint32_t tx_abrt_source;
+    volatile uint32_t txflr;
+    volatile uint32_t status;
+}
+i2c_hw_t;
+
+typedef struct i2c_inst
+{
+    i2c_hw_t* hw;
+    bool restart_on_next;
+}
+i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0            (&i2c0_inst)
+#define i2c1            (&i2c1_inst)
+#define i2c_default     i2c0
+
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t* i2c);
+uint i2c_set_baudrate(i2c_inst_t* i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop);
+
+static inline i2c_hw_t* i2c_get_hw(i2c_inst_t* i2c)
+{
+    return i2c->hw;
+}
+
+static inline size_t i2c_get_write_available(i2c_inst_t* i2c)
+{
+    (void)i2c;
+    return 16;
+}
+
+
+#endif //HARDWARE_I2C_H
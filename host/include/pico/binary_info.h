@@ -0,0 +1,16 @@
+/**
+ *
+ *  @file
+ *  @brief Host shim of the Pico SDK binary info, which has nothing to store on the host
+ *
+ **/
+
+#ifndef PICO_BINARY_INFO_H
+#define PICO_BINARY_INFO_H
+
+#define bi_decl(x)
+#define bi_2pins_with_func(p0, p1, func)
+#define bi_program_description(x)
+
+
+#endif //PICO_BINARY_INFO_H
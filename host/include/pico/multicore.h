@@ -0,0 +1,19 @@
+/**
+ *
+ *  @file
+ *  @brief Host shim of the Pico SDK multicore API: core 1 is a thread, the FIFOs are blocking queues
+ *
+ **/
+
+#ifndef PICO_MULTICORE_H
+#define PICO_MULTICORE_H
+
+#include <pico/stdlib.h>
+
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+
+
+#endif //PICO_MULTICORE_H
@@ -0,0 +1,69 @@
+/**
+ *
+ *  @file
+ *  @brief Host shim of the Pico SDK standard library subset used by the driver
+ *
+ *  Time is the host monotonic clock, core numbers follow the threads started by multicore_launch_core1.
+ *
+ **/
+
+#ifndef PICO_STDLIB_H
+#define PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+/**
+ * @def PICO_ON_DEVICE
+ * @brief Zero on the host, as in the Pico SDK host platform.
+ *
+ * @def NUM_CORES
+ * @brief Number of cores, each one backed by a host thread.
+ *
+ * @def NUM_BANK0_GPIOS
+ * @brief Number of user GPIOs of the RP2040.
+ */
+#define PICO_ON_DEVICE      0
+#define NUM_CORES           2
+#define NUM_BANK0_GPIOS     30
+
+#define PICO_OK             0
+#define PICO_ERROR_TIMEOUT  -1
+#define PICO_ERROR_GENERIC  -2
+
+#define _u(x)               x ## u
+#define count_of(a)         (sizeof(a) / sizeof((a)[0]))
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+
+bool stdio_init_all(void);
+uint64_t time_us_64(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+uint get_core_num(void);
+
+static inline uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t)(t / 1000);
+}
+
+static inline void tight_loop_contents(void)
+{
+}
+
+
+#endif //PICO_STDLIB_H
@@ -0,0 +1,185 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include <pthread.h>
+#include <pico/stdlib.h>
+#include <pico/multicore.h>
+#include <hardware/i2c.h>
+
+
+/**
+ * @def HOST_FIFO_DEPTH
+ * @brief Depth of each inter-core FIFO, as on the RP2040.
+ */
+#define HOST_FIFO_DEPTH     8
+
+
+typedef struct host_fifo_t
+{
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    uint32_t data[HOST_FIFO_DEPTH];
+    uint head;
+    uint count;
+}
+host_fifo_t;
+
+
+static void* host_core1_main(
+    void* entry
+);
+static void host_fifo_push(
+    host_fifo_t* fifo,
+    uint32_t data
+);
+static uint32_t host_fifo_pop(
+    host_fifo_t* fifo
+);
+
+
+// Aborted and stopped at once, so a register level transfer fails instead of waiting for a bus
+static i2c_hw_t host_i2c_hw[2] = {
+    { .raw_intr_stat = I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS | I2C_IC_RAW_INTR_STAT_STOP_DET_BITS },
+    { .raw_intr_stat = I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS | I2C_IC_RAW_INTR_STAT_STOP_DET_BITS },
+};
+
+i2c_inst_t i2c0_inst = { &host_i2c_hw[0], false };
+i2c_inst_t i2c1_inst = { &host_i2c_hw[1], false };
+
+static _Thread_local uint host_core_num = 0;
+
+// Index is the core popping from the FIFO
+static host_fifo_t host_fifo[NUM_CORES] = {
+    { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, { 0 }, 0, 0 },
+    { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, { 0 }, 0, 0 },
+};
+
+
+void* host_core1_main(
+    void* entry
+)
+{
+    host_core_num = 1;
+    ((void (*)(void))entry)();
+
+    return NULL;
+}
+
+void host_fifo_push(
+    host_fifo_t* fifo,
+    uint32_t data
+)
+{
+    pthread_mutex_lock(&fifo->lock);
+
+    while(fifo->count == HOST_FIFO_DEPTH)
+    {
+        pthread_cond_wait(&fifo->changed, &fifo->lock);
+    }
+
+    fifo->data[(fifo->head + fifo->count++) % HOST_FIFO_DEPTH] = data;
+
+    pthread_cond_broadcast(&fifo->changed);
+    pthread_mutex_unlock(&fifo->lock);
+}
+
+uint32_t host_fifo_pop(
+    host_fifo_t* fifo
+)
+{
+    pthread_mutex_lock(&fifo->lock);
+
+    while(fifo->count == 0)
+    {
+        pthread_cond_wait(&fifo->changed, &fifo->lock);
+    }
+
+    uint32_t data = fifo->data[fifo->head];
+
+    fifo->head = (fifo->head + 1) % HOST_FIFO_DEPTH;
+    --fifo->count;
+
+    pthread_cond_broadcast(&fifo->changed);
+    pthread_mutex_unlock(&fifo->lock);
+
+    return data;
+}
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+uint64_t time_us_64(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+void sleep_us(uint64_t us)
+{
+    struct timespec duration = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+
+    nanosleep(&duration, NULL);
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us((uint64_t)ms * 1000);
+}
+
+uint get_core_num(void)
+{
+    return host_core_num;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    pthread_t thread;
+
+    // Core 1 runs until the process exits, like a core that is never reset
+    if(pthread_create(&thread, NULL, host_core1_main, (void*)entry) == 0)
+    {
+        pthread_detach(thread);
+    }
+}
+
+void multicore_fifo_push_blocking(uint32_t data)
+{
+    host_fifo_push(&host_fifo[host_core_num ^ 1], data);
+}
+
+uint32_t multicore_fifo_pop_blocking(void)
+{
+    return host_fifo_pop(&host_fifo[host_core_num]);
+}
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t* i2c)
+{
+    (void)i2c;
+}
+
+uint i2c_set_baudrate(i2c_inst_t* i2c, uint baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop)
+{
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)len;
+    (void)nostop;
+    return PICO_ERROR_GENERIC;
+}
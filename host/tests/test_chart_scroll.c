@@ -0,0 +1,85 @@
+/**
+ *
+ *  @file
+ *  @brief Regression test of a scrolling strip chart against the display RAM it builds
+ *
+ *  Every sample moves display RAM by a one column content scroll and sends the new column.
+ *  Display RAM rebuilt by the simulator has to stay equal to the canvas after every sample.
+ *
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_chart.h"
+#include "ssd1306_replay.h"
+
+
+#define CHART_PAGE_START    2
+#define CHART_PAGE_END      6
+#define SAMPLE_COUNT        300
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count);
+
+
+uint8_t canvas_buffer[SSD1306_RAM_BUFF_SIZE];
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count)
+{
+    uint8_t txn[SSD1306_STAGING_BUFF_SIZE];
+    size_t len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        memcpy(txn + len, segments[i].data, segments[i].len);
+        len += segments[i].len;
+    }
+
+    ssd1306_replay_sim_write((ssd1306_replay_sim_t*)user_data, txn[0], txn + 1, len - 1);
+
+    return SSD1306_ERR_OK;
+}
+
+int main()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_replay_sim_t sim;
+    ssd1306_canvas_t canvas;
+    ssd1306_chart_t chart;
+    ssd1306_err_t error = SSD1306_ERR_OK;
+    int first_mismatch = -1;
+
+    ssd1306_replay_sim_init(&sim);
+
+    error = error ? error : ssd1306_init_transport_v(sim_writev, &sim);
+    error = error ? error : ssd1306_init_display(&config);
+    error = error ? error : ssd1306_canvas_init(&canvas, canvas_buffer, SSD1306_WIDTH, SSD1306_HEIGHT);
+    error = error ? error : ssd1306_chart_init(&chart, &canvas, SSD1306_CHART_SHIFT_SCROLL, CHART_PAGE_START, CHART_PAGE_END, -100, 100);
+    error = error ? error : ssd1306_chart_redraw(&chart);
+
+    for(int i = 0; i < SAMPLE_COUNT && error == SSD1306_ERR_OK; ++i)
+    {
+        // Triangle wave, so neighbouring columns join with vertical runs of both directions
+        int16_t value = (int16_t)((i % 40 < 20 ? i % 40 : 40 - i % 40) * 10 - 100);
+
+        error = ssd1306_chart_push(&chart, value);
+
+        if(first_mismatch < 0 && memcmp(&sim.ram[CHART_PAGE_START][0], &canvas_buffer[CHART_PAGE_START * SSD1306_WIDTH],
+            (CHART_PAGE_END - CHART_PAGE_START + 1) * SSD1306_WIDTH) != 0)
+        {
+            first_mismatch = i;
+        }
+    }
+
+    ssd1306_deinit_i2c();
+
+    bool is_ok = error == SSD1306_ERR_OK && first_mismatch < 0 && sim.unknown_cmds == 0;
+
+    printf("chart_scroll: %s (error %d, first mismatching sample %d, %lu unknown commands)\n",
+        is_ok ? "ok" : "FAILED", (int)error, first_mismatch, (unsigned long)sim.unknown_cmds);
+
+    return is_ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/**
+ *
+ *  @file
+ *  @brief Regression test of a contiguous transport driving the whole API through its staging buffer
+ *
+ *  Command lists and RAM data are gathered from several segments, so every one of them goes through the staging buffer.
+ *
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_arena.h"
+
+
+#define ARENA_SIZE      2048
+
+
+typedef struct capture_t {
+    uint32_t transactions;
+    uint32_t data_bytes;
+}
+capture_t;
+
+
+ssd1306_err_t capture_write(void* user_data, const uint8_t buffer[], size_t buffer_len);
+bool check(const char* name, ssd1306_err_t error, ssd1306_err_t expected);
+
+
+uint64_t arena_buffer[ARENA_SIZE / sizeof(uint64_t)];
+uint8_t frame[SSD1306_RAM_BUFF_SIZE];
+
+
+ssd1306_err_t capture_write(void* user_data, const uint8_t buffer[], size_t buffer_len)
+{
+    capture_t* capture = (capture_t*)user_data;
+
+    ++capture->transactions;
+
+    if(buffer_len > 0 && buffer[0] == 0x40)
+    {
+        capture->data_bytes += buffer_len - 1;
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+bool check(const char* name, ssd1306_err_t error, ssd1306_err_t expected)
+{
+    bool is_ok = error == expected;
+
+    printf("%s: %s (error %d, expected %d)\n", name, is_ok ? "ok" : "FAILED", (int)error, (int)expected);
+
+    return is_ok;
+}
+
+int main()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_arena_t arena;
+    uint8_t* staging_buffer = NULL;
+    capture_t capture = { 0 };
+    bool is_ok = true;
+
+    ssd1306_arena_init(&arena, (uint8_t*)arena_buffer, sizeof(arena_buffer));
+
+    is_ok &= check("alloc_staging_buffer", ssd1306_arena_alloc_staging_buffer(&arena, &staging_buffer), SSD1306_ERR_OK);
+    is_ok &= check("init_without_buffer", ssd1306_init_transport(capture_write, &capture, NULL, 0), SSD1306_ERR_NULL_DATA);
+    is_ok &= check("init_short_buffer", ssd1306_init_transport(capture_write, &capture, staging_buffer, SSD1306_STAGING_BUFF_SIZE - 1), SSD1306_ERR_INVALID_BUFF_SIZE);
+    is_ok &= check("init_transport", ssd1306_init_transport(capture_write, &capture, staging_buffer, SSD1306_STAGING_BUFF_SIZE), SSD1306_ERR_OK);
+
+    memset(frame, 0x5A, sizeof(frame));
+
+    is_ok &= check("init_display", ssd1306_init_display(&config), SSD1306_ERR_OK);
+    is_ok &= check("set_contrast", ssd1306_set_contrast(0x40), SSD1306_ERR_OK);
+    is_ok &= check("flush", ssd1306_flush(frame), SSD1306_ERR_OK);
+    is_ok &= check("set_orientation", ssd1306_set_orientation(SSD1306_ORIENTATION_180), SSD1306_ERR_OK);
+    is_ok &= check("flush_area", ssd1306_flush_area(frame, 2, 3, 16, 47), SSD1306_ERR_OK);
+
+    ssd1306_deinit_i2c();
+
+    bool is_sent = capture.data_bytes == SSD1306_RAM_BUFF_SIZE + 2 * 32;
+
+    printf("data_bytes: %s (%lu bytes in %lu transactions)\n",
+        is_sent ? "ok" : "FAILED", (unsigned long)capture.data_bytes, (unsigned long)capture.transactions);
+
+    return is_ok && is_sent ? 0 : 1;
+}
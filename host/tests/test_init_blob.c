@@ -0,0 +1,219 @@
+/**
+ *
+ *  @file
+ *  @brief Regression test of the power-up command blob against the step-by-step helper sequence
+ *
+ *  Both are sent over a capturing transport, command bytes are compared with the control bytes stripped.
+ *  Orientation commands sent after either sequence are compared the same way.
+ *
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_driver.h"
+
+
+#define CAPTURE_BUFF_SIZE   256
+
+
+typedef struct capture_t {
+    uint8_t bytes[CAPTURE_BUFF_SIZE];
+    size_t len;
+    uint32_t transactions;
+}
+capture_t;
+
+
+ssd1306_err_t capture_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count);
+ssd1306_err_t send_step_by_step(const ssd1306_init_config_t* config);
+bool check_config(const char* name, const ssd1306_init_config_t* config);
+bool check_orientation(const char* name, const ssd1306_init_config_t* config);
+bool check_malformed_blob();
+
+
+ssd1306_err_t capture_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count)
+{
+    capture_t* capture = (capture_t*)user_data;
+    bool is_control_byte = true;
+
+    ++capture->transactions;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        for(size_t j = 0; j < segments[i].len; ++j)
+        {
+            // Only command transactions are expected, the control byte is not part of the command stream
+            if(is_control_byte)
+            {
+                is_control_byte = false;
+                continue;
+            }
+            if(capture->len < CAPTURE_BUFF_SIZE)
+            {
+                capture->bytes[capture->len++] = segments[i].data[j];
+            }
+        }
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t send_step_by_step(const ssd1306_init_config_t* config)
+{
+    ssd1306_err_t error = SSD1306_ERR_OK;
+
+    // Power-up sequence as sent by the examples before the blob existed
+    error = error ? error : ssd1306_power_off();
+    error = error ? error : ssd1306_set_mem_mode_horizontal();
+    error = error ? error : ssd1306_set_display_start_line(config->display_start_line);
+    error = error ? error : (config->is_seg_remap_on ? ssd1306_seg_remap_on() : ssd1306_seg_remap_off());
+    error = error ? error : ssd1306_set_mux_ratio(config->mux_ratio);
+    error = error ? error : (config->is_com_out_scan_remap_on ? ssd1306_com_out_scan_remap_on() : ssd1306_com_out_scan_remap_off());
+    error = error ? error : ssd1306_set_display_offset(config->display_offset);
+
+    if(config->is_com_pin_config_alt)
+    {
+        error = error ? error : (config->is_com_pin_remap_on ? ssd1306_set_com_pin_config_alt_remap_on() : ssd1306_set_com_pin_config_alt_remap_off());
+    }
+    else
+    {
+        error = error ? error : (config->is_com_pin_remap_on ? ssd1306_set_com_pin_config_seq_remap_on() : ssd1306_set_com_pin_config_seq_remap_off());
+    }
+
+    error = error ? error : ssd1306_set_dclk_div_and_osc_freq(config->dclk_div_ratio, config->osc_freq_level);
+    error = error ? error : ssd1306_set_precharge_period(config->precharge_phase1_period, config->precharge_phase2_period);
+    error = error ? error : ssd1306_set_vcomh_deselect_level(config->vcomh_deselect_level);
+    error = error ? error : ssd1306_set_contrast(config->contrast);
+    error = error ? error : ssd1306_follow_ram();
+    error = error ? error : (config->is_inversion_on ? ssd1306_inversion_on() : ssd1306_inversion_off());
+    error = error ? error : (config->is_charge_pump_on ? ssd1306_charge_pump_on() : ssd1306_charge_pump_off());
+    error = error ? error : ssd1306_scroll_off();
+    error = error ? error : ssd1306_power_on();
+
+    return error;
+}
+
+bool check_config(const char* name, const ssd1306_init_config_t* config)
+{
+    capture_t blob_capture = { 0 };
+    capture_t step_capture = { 0 };
+    ssd1306_err_t blob_error;
+    ssd1306_err_t step_error;
+
+    ssd1306_init_transport_v(capture_writev, &blob_capture);
+    blob_error = ssd1306_init_display(config);
+    ssd1306_deinit_i2c();
+
+    ssd1306_init_transport_v(capture_writev, &step_capture);
+    step_error = send_step_by_step(config);
+    ssd1306_deinit_i2c();
+
+    bool is_same = blob_error == SSD1306_ERR_OK && step_error == SSD1306_ERR_OK
+        && blob_capture.transactions == 1
+        && blob_capture.len == SSD1306_INIT_BLOB_SIZE - 1
+        && blob_capture.len == step_capture.len
+        && memcmp(blob_capture.bytes, step_capture.bytes, blob_capture.len) == 0;
+
+    printf("%s: %s (blob %u bytes in %lu transactions, steps %u bytes in %lu transactions)\n",
+        name, is_same ? "ok" : "MISMATCH",
+        (unsigned int)blob_capture.len, (unsigned long)blob_capture.transactions,
+        (unsigned int)step_capture.len, (unsigned long)step_capture.transactions);
+
+    for(size_t i = 0; !is_same && i < blob_capture.len && i < step_capture.len; ++i)
+    {
+        if(blob_capture.bytes[i] != step_capture.bytes[i])
+        {
+            printf("  first difference at command byte %u: blob 0x%02X, steps 0x%02X\n",
+                (unsigned int)i, blob_capture.bytes[i], step_capture.bytes[i]);
+            break;
+        }
+    }
+
+    return is_same;
+}
+
+bool check_orientation(const char* name, const ssd1306_init_config_t* config)
+{
+    capture_t blob_capture = { 0 };
+    capture_t step_capture = { 0 };
+    ssd1306_err_t blob_error;
+    ssd1306_err_t step_error;
+
+    // Orientation is relative to the remaps of the init sequence, whichever way they were sent
+    ssd1306_init_transport_v(capture_writev, &blob_capture);
+    blob_error = ssd1306_init_display(config);
+    blob_capture.len = 0;
+    blob_error = blob_error ? blob_error : ssd1306_set_orientation(SSD1306_ORIENTATION_180);
+    ssd1306_deinit_i2c();
+
+    ssd1306_init_transport_v(capture_writev, &step_capture);
+    step_error = send_step_by_step(config);
+    step_capture.len = 0;
+    step_error = step_error ? step_error : ssd1306_set_orientation(SSD1306_ORIENTATION_180);
+    ssd1306_deinit_i2c();
+
+    bool is_same = blob_error == SSD1306_ERR_OK && step_error == SSD1306_ERR_OK
+        && blob_capture.len > 0
+        && blob_capture.len == step_capture.len
+        && memcmp(blob_capture.bytes, step_capture.bytes, blob_capture.len) == 0;
+
+    printf("%s_orientation: %s (blob %u bytes, steps %u bytes)\n",
+        name, is_same ? "ok" : "MISMATCH", (unsigned int)blob_capture.len, (unsigned int)step_capture.len);
+
+    return is_same;
+}
+
+bool check_malformed_blob()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    capture_t capture = { 0 };
+    uint8_t blob[SSD1306_INIT_BLOB_SIZE];
+    bool is_ok = ssd1306_build_init_blob(&config, blob) == SSD1306_ERR_OK;
+
+    // Command in front of the multiplex ratio replaced, so its value can't be trusted
+    blob[SSD1306_INIT_BLOB_MUX_RATIO_IDX - 1] = 0xE3;
+
+    ssd1306_init_transport_v(capture_writev, &capture);
+    is_ok = is_ok && ssd1306_send_init_blob(blob) == SSD1306_ERR_INVALID_INIT_BLOB && capture.transactions == 0;
+    ssd1306_deinit_i2c();
+
+    printf("malformed_blob: %s (%lu transactions sent)\n", is_ok ? "ok" : "ACCEPTED", (unsigned long)capture.transactions);
+
+    return is_ok;
+}
+
+int main()
+{
+    const ssd1306_init_config_t default_config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_init_config_t short_panel_config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_init_config_t flipped_config = SSD1306_INIT_CONFIG_DEFAULT;
+
+    short_panel_config.mux_ratio = 31;
+    short_panel_config.is_com_pin_config_alt = false;
+    short_panel_config.display_offset = 5;
+    short_panel_config.contrast = 0x10;
+    short_panel_config.dclk_div_ratio = 3;
+    short_panel_config.osc_freq_level = 12;
+    short_panel_config.vcomh_deselect_level = SSD1306_VCOMH_DESELECT_LVL_0_65;
+
+    flipped_config.display_start_line = 17;
+    flipped_config.is_seg_remap_on = false;
+    flipped_config.is_com_out_scan_remap_on = false;
+    flipped_config.is_com_pin_remap_on = true;
+    flipped_config.precharge_phase1_period = 2;
+    flipped_config.precharge_phase2_period = 2;
+    flipped_config.is_inversion_on = true;
+    flipped_config.is_charge_pump_on = false;
+
+    bool is_ok = true;
+
+    is_ok &= check_config("default", &default_config);
+    is_ok &= check_config("short_panel", &short_panel_config);
+    is_ok &= check_config("flipped", &flipped_config);
+    is_ok &= check_orientation("default", &default_config);
+    is_ok &= check_orientation("flipped", &flipped_config);
+    is_ok &= check_malformed_blob();
+
+    return is_ok ? 0 : 1;
+}
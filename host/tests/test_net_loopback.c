@@ -0,0 +1,309 @@
+/**
+ *
+ *  @file
+ *  @brief Loopback test of the display server over UDP sockets on the host
+ *
+ *  A controller encodes regions of its frame and sends them to a local socket, the server socket feeds
+ *  ssd1306_net_server_receive and replies through the same socket. The driver flushes into a simulated
+ *  controller, the RAM of which must end up equal to the controller frame.
+ *
+ **/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_net.h"
+#include "ssd1306_replay.h"
+
+
+#define LOOPBACK_TIMEOUT_US     200000
+
+
+typedef struct loopback_t {
+    int server_fd;
+    int client_fd;
+    struct sockaddr_in server_addr;
+    struct sockaddr_in peer_addr;
+}
+loopback_t;
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count);
+ssd1306_err_t loopback_reply(void* user_data, const uint8_t buffer[], size_t buffer_len);
+bool loopback_open(loopback_t* loopback);
+void loopback_close(loopback_t* loopback);
+ssd1306_err_t serve_packet(loopback_t* loopback, ssd1306_net_server_t* server);
+bool receive_reply(loopback_t* loopback, uint8_t buffer[], size_t buffer_cap, size_t* buffer_len);
+size_t build_update(uint8_t packet[], uint8_t flags, uint16_t seq, const uint8_t frame[], uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end);
+void send_packet(loopback_t* loopback, const uint8_t packet[], size_t packet_len);
+uint32_t read_u32(const uint8_t bytes[]);
+bool check(bool is_ok, const char* name);
+bool check_rle_round_trip();
+
+
+static bool is_all_ok = true;
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count)
+{
+    ssd1306_replay_sim_t* sim = (ssd1306_replay_sim_t*)user_data;
+    uint8_t txn[SSD1306_STAGING_BUFF_SIZE];
+    size_t txn_len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        memcpy(txn + txn_len, segments[i].data, segments[i].len);
+        txn_len += segments[i].len;
+    }
+
+    ssd1306_replay_sim_write(sim, txn[0], txn + 1, txn_len - 1);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t loopback_reply(void* user_data, const uint8_t buffer[], size_t buffer_len)
+{
+    loopback_t* loopback = (loopback_t*)user_data;
+    ssize_t sent = sendto(loopback->server_fd, buffer, buffer_len, 0, (const struct sockaddr*)&loopback->peer_addr, sizeof(loopback->peer_addr));
+
+    return sent == (ssize_t)buffer_len ? SSD1306_ERR_OK : SSD1306_ERR_NET_ERROR;
+}
+
+bool loopback_open(loopback_t* loopback)
+{
+    struct timeval timeout = { 0, LOOPBACK_TIMEOUT_US };
+    socklen_t addr_len = sizeof(loopback->server_addr);
+
+    memset(loopback, 0, sizeof(loopback_t));
+
+    loopback->server_addr.sin_family = AF_INET;
+    loopback->server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    loopback->server_addr.sin_port = 0;
+
+    loopback->server_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    loopback->client_fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    // Port is picked by the system, so parallel test runs don't collide
+    return loopback->server_fd >= 0 && loopback->client_fd >= 0
+        && bind(loopback->server_fd, (const struct sockaddr*)&loopback->server_addr, sizeof(loopback->server_addr)) == 0
+        && getsockname(loopback->server_fd, (struct sockaddr*)&loopback->server_addr, &addr_len) == 0
+        && setsockopt(loopback->server_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0
+        && setsockopt(loopback->client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+void loopback_close(loopback_t* loopback)
+{
+    close(loopback->server_fd);
+    close(loopback->client_fd);
+}
+
+ssd1306_err_t serve_packet(loopback_t* loopback, ssd1306_net_server_t* server)
+{
+    uint8_t packet[SSD1306_NET_MAX_PACKET_SIZE];
+    socklen_t addr_len = sizeof(loopback->peer_addr);
+    ssize_t packet_len = recvfrom(loopback->server_fd, packet, sizeof(packet), 0, (struct sockaddr*)&loopback->peer_addr, &addr_len);
+
+    if(packet_len < 0)
+    {
+        return SSD1306_ERR_NET_ERROR;
+    }
+
+    return ssd1306_net_server_receive(server, packet, packet_len);
+}
+
+bool receive_reply(loopback_t* loopback, uint8_t buffer[], size_t buffer_cap, size_t* buffer_len)
+{
+    ssize_t len = recv(loopback->client_fd, buffer, buffer_cap, 0);
+
+    *buffer_len = len > 0 ? len : 0;
+
+    return len > 0;
+}
+
+size_t build_update(uint8_t packet[], uint8_t flags, uint16_t seq, const uint8_t frame[], uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end)
+{
+    size_t pos = ssd1306_net_write_header(packet, flags, seq, page_end - page_start + 1);
+
+    for(uint8_t page = page_start; page <= page_end; ++page)
+    {
+        size_t payload_len = 0;
+
+        ssd1306_net_rle_encode(
+            frame + page * SSD1306_WIDTH + col_start, col_end - col_start + 1,
+            packet + pos + SSD1306_NET_REGION_HEADER_SIZE, SSD1306_NET_MAX_PACKET_SIZE - pos - SSD1306_NET_REGION_HEADER_SIZE,
+            &payload_len
+        );
+
+        packet[pos++] = page;
+        packet[pos++] = col_start;
+        packet[pos++] = col_end;
+        packet[pos++] = payload_len & 0xFF;
+        packet[pos++] = payload_len >> 8;
+        pos += payload_len;
+    }
+
+    return pos;
+}
+
+void send_packet(loopback_t* loopback, const uint8_t packet[], size_t packet_len)
+{
+    sendto(loopback->client_fd, packet, packet_len, 0, (const struct sockaddr*)&loopback->server_addr, sizeof(loopback->server_addr));
+}
+
+uint32_t read_u32(const uint8_t bytes[])
+{
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+bool check(bool is_ok, const char* name)
+{
+    printf("%s: %s\n", name, is_ok ? "ok" : "FAILED");
+    is_all_ok &= is_ok;
+
+    return is_ok;
+}
+
+bool check_rle_round_trip()
+{
+    uint8_t src[600];
+    uint8_t encoded[sizeof(src) + sizeof(src) / 128 + 1];
+    uint8_t decoded[sizeof(src)];
+
+    srand(1);
+
+    for(size_t len = 1; len <= sizeof(src); len += 7)
+    {
+        size_t encoded_len = 0;
+
+        // Short random runs mix literals and repeats
+        for(size_t i = 0; i < len; ++i)
+        {
+            src[i] = i > 0 && rand() % 3 ? src[i - 1] : rand() % 4;
+        }
+
+        if(!ssd1306_net_rle_encode(src, len, encoded, sizeof(encoded), &encoded_len)
+        || !ssd1306_net_rle_decode(encoded, encoded_len, decoded, len)
+        || memcmp(src, decoded, len) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main()
+{
+    static uint8_t controller_frame[SSD1306_RAM_BUFF_SIZE];
+    static uint8_t server_frame[SSD1306_RAM_BUFF_SIZE];
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    uint8_t packet[SSD1306_NET_MAX_PACKET_SIZE];
+    uint8_t reply[SSD1306_NET_MAX_PACKET_SIZE];
+    size_t packet_len;
+    size_t reply_len;
+    ssd1306_replay_sim_t sim;
+    ssd1306_net_server_t server;
+    loopback_t loopback;
+
+    check(check_rle_round_trip(), "rle_round_trip");
+
+    if(!check(loopback_open(&loopback), "loopback_open"))
+    {
+        return 1;
+    }
+
+    ssd1306_replay_sim_init(&sim);
+    ssd1306_init_transport_v(sim_writev, &sim);
+    ssd1306_init_display(&config);
+    ssd1306_net_server_init(&server, server_frame, loopback_reply, &loopback);
+
+    for(size_t i = 0; i < SSD1306_RAM_BUFF_SIZE; ++i)
+    {
+        controller_frame[i] = i / SSD1306_WIDTH == 2 ? 0xFF : (uint8_t)(i * 7 ^ i >> 3);
+    }
+
+    // Whole frame as a keyframe
+    packet_len = build_update(packet, SSD1306_NET_FLAG_KEYFRAME | SSD1306_NET_FLAG_FLUSH, 100, controller_frame, 0, SSD1306_PAGE_COUNT - 1, 0, SSD1306_WIDTH - 1);
+    send_packet(&loopback, packet, packet_len);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_OK, "keyframe_received");
+    check(memcmp(sim.ram, controller_frame, SSD1306_RAM_BUFF_SIZE) == 0, "keyframe_shown");
+
+    // Dirty regions of two pages
+    memset(controller_frame + 3 * SSD1306_WIDTH + 10, 0x3C, 11);
+    memset(controller_frame + 4 * SSD1306_WIDTH + 10, 0x00, 11);
+    packet_len = build_update(packet, SSD1306_NET_FLAG_FLUSH, 101, controller_frame, 3, 4, 10, 20);
+    send_packet(&loopback, packet, packet_len);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_OK, "update_received");
+    check(memcmp(sim.ram, controller_frame, SSD1306_RAM_BUFF_SIZE) == 0, "update_shown");
+
+    // Duplicate is dropped without a reply
+    send_packet(&loopback, packet, packet_len);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_OK, "duplicate_received");
+    check(server.decoder.stats.dropped_stale == 1, "duplicate_dropped");
+    check(!receive_reply(&loopback, reply, sizeof(reply), &reply_len), "duplicate_not_answered");
+
+    // Gap is applied and answered with a NACK of the first missing packet
+    memset(controller_frame + 7 * SSD1306_WIDTH, 0xA5, 6);
+    packet_len = build_update(packet, SSD1306_NET_FLAG_FLUSH, 104, controller_frame, 7, 7, 0, 5);
+    send_packet(&loopback, packet, packet_len);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_OK, "gap_received");
+    check(memcmp(sim.ram, controller_frame, SSD1306_RAM_BUFF_SIZE) == 0, "gap_shown");
+    check(server.decoder.stats.lost == 2, "gap_counted");
+    check(receive_reply(&loopback, reply, sizeof(reply), &reply_len)
+        && reply_len == SSD1306_NET_HEADER_SIZE
+        && reply[3] == SSD1306_NET_FLAG_NACK
+        && (reply[4] | reply[5] << 8) == 102, "gap_nacked");
+
+    // Truncated packet is dropped as a whole
+    uint8_t changed_frame[SSD1306_RAM_BUFF_SIZE];
+
+    memset(changed_frame, 0x55, sizeof(changed_frame));
+    packet_len = build_update(packet, SSD1306_NET_FLAG_FLUSH, 105, changed_frame, 0, 1, 0, SSD1306_WIDTH - 1);
+    send_packet(&loopback, packet, packet_len - 1);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_INVALID_NET_PACKET, "malformed_rejected");
+    check(server.decoder.stats.dropped_malformed == 1, "malformed_dropped");
+    check(memcmp(sim.ram, controller_frame, SSD1306_RAM_BUFF_SIZE) == 0, "malformed_not_shown");
+
+    // Telemetry request is answered with the driver and packet counters
+    ssd1306_stats_t stats;
+
+    ssd1306_get_stats(&stats);
+    ssd1306_net_write_header(packet, SSD1306_NET_FLAG_STATS, 7, 0);
+    send_packet(&loopback, packet, SSD1306_NET_HEADER_SIZE);
+
+    check(serve_packet(&loopback, &server) == SSD1306_ERR_OK, "stats_received");
+    check(receive_reply(&loopback, reply, sizeof(reply), &reply_len)
+        && reply_len >= SSD1306_NET_HEADER_SIZE + 17 * 4 + 1
+        && reply_len == SSD1306_NET_HEADER_SIZE + 17 * 4 + 1 + 5 * reply[SSD1306_NET_HEADER_SIZE + 17 * 4]
+        && reply[3] == SSD1306_NET_FLAG_STATS
+        && (reply[4] | reply[5] << 8) == 7
+        && read_u32(reply + SSD1306_NET_HEADER_SIZE + 1 * 4) == stats.transactions
+        && read_u32(reply + SSD1306_NET_HEADER_SIZE + 8 * 4) == stats.flushes
+        && read_u32(reply + SSD1306_NET_HEADER_SIZE + 12 * 4) == server.decoder.stats.packets
+        && read_u32(reply + SSD1306_NET_HEADER_SIZE + 13 * 4) == server.decoder.stats.applied
+        && read_u32(reply + SSD1306_NET_HEADER_SIZE + 16 * 4) == server.decoder.stats.lost, "stats_answered");
+
+    // Errors of building the reply are returned instead of sending a reply of undefined length
+    uint8_t small_reply[SSD1306_NET_HEADER_SIZE];
+
+    check(ssd1306_net_build_stats(&server, 8, small_reply, sizeof(small_reply), &reply_len) == SSD1306_ERR_INVALID_BUFF_SIZE, "stats_buffer_checked");
+
+    ssd1306_deinit_i2c();
+    loopback_close(&loopback);
+
+    return is_all_ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ *
+ *  @file
+ *  @brief Regression test of frames replayed from a recorded log against the flushes that produced them
+ *
+ *  Flushes sending several runs of RAM data, with commands in between, have to replay as a single frame each.
+ *
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_recorder.h"
+#include "ssd1306_replay.h"
+
+
+#define LOG_BUFF_SIZE       8192
+#define FLUSH_COUNT         3
+
+
+typedef struct frame_check_t {
+    uint8_t expected[FLUSH_COUNT][SSD1306_RAM_BUFF_SIZE];
+    uint32_t frames;
+    uint32_t mismatches;
+}
+frame_check_t;
+
+
+void check_frame(void* user_data, const ssd1306_replay_sim_t* sim, uint32_t frame_idx, uint64_t timestamp_us);
+
+
+uint8_t log_buffer[LOG_BUFF_SIZE];
+uint8_t frame[SSD1306_RAM_BUFF_SIZE];
+frame_check_t check;
+
+
+void check_frame(void* user_data, const ssd1306_replay_sim_t* sim, uint32_t frame_idx, uint64_t timestamp_us)
+{
+    frame_check_t* frame_check = (frame_check_t*)user_data;
+
+    (void)timestamp_us;
+
+    ++frame_check->frames;
+
+    if(frame_idx >= FLUSH_COUNT || memcmp(sim->ram, frame_check->expected[frame_idx], SSD1306_RAM_BUFF_SIZE) != 0)
+    {
+        printf("  frame %lu does not match its flush\n", (unsigned long)frame_idx);
+        ++frame_check->mismatches;
+    }
+}
+
+int main()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_recorder_t recorder;
+    ssd1306_stats_t driver_stats;
+    ssd1306_replay_stats_t replay_stats;
+    ssd1306_replay_sim_t sim;
+    ssd1306_err_t error = SSD1306_ERR_OK;
+
+    error = error ? error : ssd1306_recorder_init(&recorder, log_buffer, sizeof(log_buffer), NULL, NULL);
+    error = error ? error : ssd1306_init_transport_v(ssd1306_recorder_writev, &recorder);
+    error = error ? error : ssd1306_init_display(&config);
+    error = error ? error : ssd1306_set_flush_hook(ssd1306_recorder_mark_frame, &recorder);
+
+    // Full frame first, then two pages far apart, sent as separate runs with an address window each
+    for(size_t i = 0; i < SSD1306_RAM_BUFF_SIZE; ++i)
+    {
+        frame[i] = (uint8_t)(i * 7);
+    }
+
+    error = error ? error : ssd1306_flush(frame);
+    memcpy(check.expected[0], frame, SSD1306_RAM_BUFF_SIZE);
+
+    memset(&frame[1 * SSD1306_WIDTH], 0xAA, SSD1306_WIDTH);
+    memset(&frame[5 * SSD1306_WIDTH], 0x55, SSD1306_WIDTH);
+
+    error = error ? error : ssd1306_flush(frame);
+    memcpy(check.expected[1], frame, SSD1306_RAM_BUFF_SIZE);
+
+    memset(&frame[3 * SSD1306_WIDTH + 10], 0xFF, 20);
+    memset(&frame[4 * SSD1306_WIDTH + 10], 0xFF, 20);
+
+    error = error ? error : ssd1306_flush_area(frame, 3, 4, 10, 29);
+    memcpy(check.expected[2], frame, SSD1306_RAM_BUFF_SIZE);
+
+    error = error ? error : ssd1306_get_stats(&driver_stats);
+    ssd1306_deinit_i2c();
+
+    if(error != SSD1306_ERR_OK)
+    {
+        printf("driver error %d\n", (int)error);
+        return 1;
+    }
+
+    ssd1306_replay_sim_init(&sim);
+
+    bool is_complete = ssd1306_replay_log(log_buffer, recorder.used, &sim, &replay_stats, check_frame, &check);
+    bool is_ok = is_complete && recorder.dropped == 0
+        && replay_stats.frames == driver_stats.flushes
+        && check.frames == FLUSH_COUNT
+        && check.mismatches == 0
+        && replay_stats.transactions == driver_stats.transactions
+        && replay_stats.data_transactions == driver_stats.data_transactions;
+
+    printf("replay_frames: %s (%lu frames replayed, %lu flushes, %lu of %lu data transactions)\n",
+        is_ok ? "ok" : "MISMATCH",
+        (unsigned long)replay_stats.frames, (unsigned long)driver_stats.flushes,
+        (unsigned long)replay_stats.data_transactions, (unsigned long)driver_stats.data_transactions);
+
+    return is_ok ? 0 : 1;
+}
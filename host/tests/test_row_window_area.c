@@ -0,0 +1,96 @@
+/**
+ *
+ *  @file
+ *  @brief Regression test of area flushes with a row window set
+ *
+ *  Area pages are RAM pages inside the window, read from a frame covering only the window.
+ *  Display RAM rebuilt by the simulator from the sent command stream is compared with the window frame.
+ *
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_replay.h"
+
+
+#define WINDOW_PAGE_START   2
+#define WINDOW_PAGE_COUNT   4
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count);
+bool check(const char* name, ssd1306_err_t error, ssd1306_err_t expected);
+
+
+uint8_t window_frame[SSD1306_WINDOW_FRAME_SIZE(WINDOW_PAGE_COUNT)];
+
+
+ssd1306_err_t sim_writev(void* user_data, const ssd1306_iovec_t segments[], size_t segment_count)
+{
+    uint8_t txn[SSD1306_STAGING_BUFF_SIZE];
+    size_t len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        memcpy(txn + len, segments[i].data, segments[i].len);
+        len += segments[i].len;
+    }
+
+    ssd1306_replay_sim_write((ssd1306_replay_sim_t*)user_data, txn[0], txn + 1, len - 1);
+
+    return SSD1306_ERR_OK;
+}
+
+bool check(const char* name, ssd1306_err_t error, ssd1306_err_t expected)
+{
+    bool is_ok = error == expected;
+
+    printf("%s: %s (error %d, expected %d)\n", name, is_ok ? "ok" : "FAILED", (int)error, (int)expected);
+
+    return is_ok;
+}
+
+int main()
+{
+    const ssd1306_init_config_t config = SSD1306_INIT_CONFIG_DEFAULT;
+    ssd1306_replay_sim_t sim;
+    bool is_ok = true;
+
+    ssd1306_replay_sim_init(&sim);
+
+    for(size_t i = 0; i < sizeof(window_frame); ++i)
+    {
+        window_frame[i] = (uint8_t)(i * 3 + 1);
+    }
+
+    is_ok &= check("init_transport_v", ssd1306_init_transport_v(sim_writev, &sim), SSD1306_ERR_OK);
+    is_ok &= check("init_display", ssd1306_init_display(&config), SSD1306_ERR_OK);
+    is_ok &= check("set_row_window", ssd1306_set_row_window(WINDOW_PAGE_START, WINDOW_PAGE_COUNT), SSD1306_ERR_OK);
+
+    // Pages outside of the window are not in the frame
+    is_ok &= check("area_above_window", ssd1306_flush_area(window_frame, WINDOW_PAGE_START - 1, WINDOW_PAGE_START, 0, 7), SSD1306_ERR_INVALID_PAGE);
+    is_ok &= check("area_below_window", ssd1306_flush_area(window_frame, WINDOW_PAGE_START, WINDOW_PAGE_START + WINDOW_PAGE_COUNT, 0, 7), SSD1306_ERR_INVALID_PAGE);
+
+    is_ok &= check("full_width_area", ssd1306_flush_area(window_frame, WINDOW_PAGE_START + 2, WINDOW_PAGE_START + 3, 0, SSD1306_WIDTH - 1), SSD1306_ERR_OK);
+    is_ok &= check("partial_area", ssd1306_flush_area(window_frame, WINDOW_PAGE_START, WINDOW_PAGE_START + 1, 20, 59), SSD1306_ERR_OK);
+
+    ssd1306_deinit_i2c();
+
+    uint32_t mismatches = 0;
+
+    for(uint8_t page = 0; page < WINDOW_PAGE_COUNT; ++page)
+    {
+        uint8_t col_start = page < 2 ? 20 : 0;
+        uint8_t col_end = page < 2 ? 59 : SSD1306_WIDTH - 1;
+
+        for(uint8_t col = col_start; col <= col_end; ++col)
+        {
+            mismatches += sim.ram[WINDOW_PAGE_START + page][col] != window_frame[page * SSD1306_WIDTH + col];
+        }
+    }
+
+    printf("window_ram: %s (%lu mismatching bytes)\n", mismatches == 0 ? "ok" : "FAILED", (unsigned long)mismatches);
+
+    return is_ok && mismatches == 0 ? 0 : 1;
+}
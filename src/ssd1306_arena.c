@@ -0,0 +1,154 @@
+#include <string.h>
+
+#include "ssd1306_arena.h"
+
+
+ssd1306_err_t ssd1306_memory_requirements(
+    const ssd1306_memory_config_t* config,
+    size_t* arena_size
+)
+{
+    if(config == NULL || arena_size == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(config->frame_count > 0 && (config->frame_page_count == 0 || config->frame_page_count > SSD1306_PAGE_COUNT))
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(config->canvas_height % SSD1306_PAGE_HEIGHT != 0)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    *arena_size = config->instance_count * SSD1306_ARENA_INSTANCE_SIZE
+        + config->staging_buffer_count * SSD1306_ARENA_STAGING_BUFF_SIZE
+        + config->frame_count * SSD1306_ARENA_FRAME_SIZE(config->frame_page_count)
+        + config->canvas_count * SSD1306_ARENA_CANVAS_SIZE(config->canvas_width, config->canvas_height);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_arena_init(
+    ssd1306_arena_t* arena,
+    uint8_t buffer[],
+    size_t size
+)
+{
+    if(arena == NULL || buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    arena->buffer = buffer;
+    arena->size = size;
+    arena->used = 0;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_arena_alloc(
+    ssd1306_arena_t* arena,
+    size_t size,
+    void** block
+)
+{
+    if(arena == NULL || block == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    // Padding is counted from the address, so misaligned arenas still give aligned blocks
+    size_t padding = -(uintptr_t)(arena->buffer + arena->used) & (SSD1306_ARENA_ALIGN - 1);
+    size_t block_size = SSD1306_ARENA_BLOCK_SIZE(size);
+
+    if(arena->size - arena->used < padding + block_size)
+    {
+        return SSD1306_ERR_ARENA_FULL;
+    }
+
+    *block = arena->buffer + arena->used + padding;
+    arena->used += padding + block_size;
+
+    memset(*block, 0, block_size);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_arena_alloc_instance(
+    ssd1306_arena_t* arena,
+    ssd1306_instance_t** instance
+)
+{
+    if(arena == NULL || instance == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    return ssd1306_arena_alloc(arena, sizeof(ssd1306_instance_t), (void**)instance);
+}
+
+ssd1306_err_t ssd1306_arena_alloc_staging_buffer(
+    ssd1306_arena_t* arena,
+    uint8_t** staging_buffer
+)
+{
+    if(arena == NULL || staging_buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    return ssd1306_arena_alloc(arena, SSD1306_STAGING_BUFF_SIZE, (void**)staging_buffer);
+}
+
+ssd1306_err_t ssd1306_arena_alloc_frame(
+    ssd1306_arena_t* arena,
+    uint8_t page_count,
+    uint8_t** prefixed_frame
+)
+{
+    if(page_count == 0 || page_count > SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+
+    return ssd1306_arena_alloc(arena, SSD1306_WINDOW_PREFIXED_FRAME_SIZE(page_count), (void**)prefixed_frame);
+}
+
+ssd1306_err_t ssd1306_arena_alloc_canvas(
+    ssd1306_arena_t* arena,
+    ssd1306_canvas_t* canvas,
+    uint16_t width,
+    uint16_t height
+)
+{
+    if(canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(width == 0)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(height == 0 || height % SSD1306_PAGE_HEIGHT != 0)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    void* buffer = NULL;
+    ssd1306_err_t error = ssd1306_arena_alloc(arena, width * (height / SSD1306_PAGE_HEIGHT), &buffer);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    return ssd1306_canvas_init(canvas, buffer, width, height);
+}
+
+void ssd1306_arena_reset(
+    ssd1306_arena_t* arena
+)
+{
+    arena->used = 0;
+}
@@ -0,0 +1,181 @@
+/**
+ *
+ *  @file
+ *  @brief Static memory arena the working memory of displays and canvases is taken from
+ *
+ **/
+
+#ifndef SSD1306_ARENA_H
+#define SSD1306_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_ARENA_ALIGN
+ * @brief Alignment of every block taken from an arena in bytes.
+ *
+ * @def SSD1306_ARENA_BLOCK_SIZE
+ * @brief Arena space taken by a block of size bytes.
+ *
+ * @def SSD1306_ARENA_INSTANCE_SIZE
+ * @brief Arena space taken by ssd1306_arena_alloc_instance.
+ *
+ * @def SSD1306_ARENA_STAGING_BUFF_SIZE
+ * @brief Arena space taken by ssd1306_arena_alloc_staging_buffer.
+ *
+ * @def SSD1306_ARENA_FRAME_SIZE
+ * @brief Arena space taken by ssd1306_arena_alloc_frame for a prefixed frame page_count pages high.
+ *
+ * @def SSD1306_ARENA_CANVAS_SIZE
+ * @brief Arena space taken by ssd1306_arena_alloc_canvas for a canvas of width x height pixels.
+ */
+#define SSD1306_ARENA_ALIGN                         _u(8)
+#define SSD1306_ARENA_BLOCK_SIZE(size)              (((size) + SSD1306_ARENA_ALIGN - 1) / SSD1306_ARENA_ALIGN * SSD1306_ARENA_ALIGN)
+#define SSD1306_ARENA_INSTANCE_SIZE                 SSD1306_ARENA_BLOCK_SIZE(sizeof(ssd1306_instance_t))
+#define SSD1306_ARENA_STAGING_BUFF_SIZE             SSD1306_ARENA_BLOCK_SIZE(SSD1306_STAGING_BUFF_SIZE)
+#define SSD1306_ARENA_FRAME_SIZE(page_count)        SSD1306_ARENA_BLOCK_SIZE(SSD1306_WINDOW_PREFIXED_FRAME_SIZE(page_count))
+#define SSD1306_ARENA_CANVAS_SIZE(width, height)    SSD1306_ARENA_BLOCK_SIZE((width) * ((height) / SSD1306_PAGE_HEIGHT))
+
+
+/**
+ * @struct ssd1306_arena_t
+ * @brief Caller provided memory blocks are taken from in order. Blocks are only given back all at once.
+ */
+typedef struct ssd1306_arena_t
+{
+    uint8_t* buffer;    /**< Arena memory. */
+    size_t size;        /**< Size of the arena memory. */
+    size_t used;        /**< Bytes taken so far, alignment padding included. */
+}
+ssd1306_arena_t;
+
+/**
+ * @struct ssd1306_memory_config_t
+ * @brief Memory layout of an application, see ssd1306_memory_requirements.
+ */
+typedef struct ssd1306_memory_config_t
+{
+    size_t instance_count;           /**< Number of display instances. */
+    size_t staging_buffer_count;     /**< Number of staging buffers, one per display driven by ssd1306_init_transport. */
+    size_t frame_count;              /**< Number of prefixed frames, e.g. 2 per display for double buffering. */
+    uint8_t frame_page_count;        /**< Pages of every frame, SSD1306_PAGE_COUNT unless a row window is set. */
+    size_t canvas_count;             /**< Number of additional canvases, e.g. virtual or wall canvases. */
+    uint16_t canvas_width;           /**< Width of every additional canvas in pixels. */
+    uint16_t canvas_height;          /**< Height of every additional canvas in pixels, multiple of SSD1306_PAGE_HEIGHT. */
+}
+ssd1306_memory_config_t;
+
+
+/**
+ * @brief Get the arena size needed by a memory layout, same as summing the SSD1306_ARENA_*_SIZE macros.
+ * Arena buffer must be SSD1306_ARENA_ALIGN aligned, e.g. a uint64_t array, for the size to be exact.
+ *
+ * @param config Memory layout.
+ * @param arena_size Pointer to store the arena size in bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_memory_requirements(
+    const ssd1306_memory_config_t* config,
+    size_t* arena_size
+);
+
+/**
+ * @brief Initializes an empty arena over caller provided memory.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param buffer Arena memory, preferably SSD1306_ARENA_ALIGN aligned.
+ * @param size Size of the arena memory.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_init(
+    ssd1306_arena_t* arena,
+    uint8_t buffer[],
+    size_t size
+);
+
+/**
+ * @brief Takes a zeroed SSD1306_ARENA_ALIGN aligned block from the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param size Size of the block in bytes.
+ * @param block Pointer to store the block address.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_alloc(
+    ssd1306_arena_t* arena,
+    size_t size,
+    void** block
+);
+
+/**
+ * @brief Takes a display instance from the arena.
+ * Instance is not initialized, select it and initialize it as usual.
+ *
+ * @param arena Pointer to the arena.
+ * @param instance Pointer to store the instance address.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_alloc_instance(
+    ssd1306_arena_t* arena,
+    ssd1306_instance_t** instance
+);
+
+/**
+ * @brief Takes a staging buffer of SSD1306_STAGING_BUFF_SIZE bytes from the arena, to be passed to ssd1306_init_transport.
+ * Only displays driven by a contiguous transport need one.
+ *
+ * @param arena Pointer to the arena.
+ * @param staging_buffer Pointer to store the address of the staging buffer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_alloc_staging_buffer(
+    ssd1306_arena_t* arena,
+    uint8_t** staging_buffer
+);
+
+/**
+ * @brief Takes a cleared prefixed frame from the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param page_count Pages of the frame. [1, SSD1306_PAGE_COUNT]
+ * @param prefixed_frame Pointer to store the address of SSD1306_WINDOW_PREFIXED_FRAME_SIZE(page_count) bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_alloc_frame(
+    ssd1306_arena_t* arena,
+    uint8_t page_count,
+    uint8_t** prefixed_frame
+);
+
+/**
+ * @brief Takes the buffer of a cleared canvas from the arena and initializes the canvas over it.
+ *
+ * @param arena Pointer to the arena.
+ * @param canvas Pointer to the canvas to initialize.
+ * @param width Canvas width in pixels.
+ * @param height Canvas height in pixels, multiple of SSD1306_PAGE_HEIGHT.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_arena_alloc_canvas(
+    ssd1306_arena_t* arena,
+    ssd1306_canvas_t* canvas,
+    uint16_t width,
+    uint16_t height
+);
+
+/**
+ * @brief Gives all blocks back to the arena. Instances taken from it must be deinitialized first.
+ *
+ * @param arena Pointer to the arena.
+ */
+void ssd1306_arena_reset(
+    ssd1306_arena_t* arena
+);
+
+
+#endif //SSD1306_ARENA_H
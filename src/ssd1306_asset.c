@@ -0,0 +1,174 @@
+#include <string.h>
+
+#include "ssd1306_asset.h"
+
+
+static uint16_t ssd1306_asset_read_u16(
+    const uint8_t bytes[]
+);
+static uint32_t ssd1306_asset_read_u32(
+    const uint8_t bytes[]
+);
+
+
+uint16_t ssd1306_asset_read_u16(
+    const uint8_t bytes[]
+)
+{
+    return (uint16_t)bytes[0] | (uint16_t)bytes[1] << 8;
+}
+
+uint32_t ssd1306_asset_read_u32(
+    const uint8_t bytes[]
+)
+{
+    return (uint32_t)ssd1306_asset_read_u16(bytes) | (uint32_t)ssd1306_asset_read_u16(bytes + 2) << 16;
+}
+
+ssd1306_err_t ssd1306_asset_pack_open(
+    ssd1306_asset_pack_t* pack,
+    const uint8_t blob[],
+    size_t blob_len
+)
+{
+    if(pack == NULL || blob == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(blob_len < SSD1306_ASSET_PACK_HEADER_SIZE || memcmp(blob, SSD1306_ASSET_PACK_MAGIC, 4) != 0)
+    {
+        return SSD1306_ERR_INVALID_ASSET_PACK;
+    }
+
+    uint16_t asset_count = ssd1306_asset_read_u16(blob + 4);
+
+    if(blob_len < SSD1306_ASSET_PACK_HEADER_SIZE + (size_t)asset_count * SSD1306_ASSET_PACK_ENTRY_SIZE)
+    {
+        return SSD1306_ERR_INVALID_ASSET_PACK;
+    }
+
+    // Bounds are checked once here, so lookups and streaming never read past the blob
+    for(uint16_t i = 0; i < asset_count; ++i)
+    {
+        const uint8_t* entry = blob + SSD1306_ASSET_PACK_HEADER_SIZE + i * SSD1306_ASSET_PACK_ENTRY_SIZE;
+        size_t offset = ssd1306_asset_read_u32(entry);
+        uint16_t width = ssd1306_asset_read_u16(entry + 4);
+        uint16_t height = ssd1306_asset_read_u16(entry + 6);
+        size_t size = (size_t)width * ((height + SSD1306_PAGE_HEIGHT - 1) / SSD1306_PAGE_HEIGHT);
+
+        if(width == 0 || height == 0 || offset > blob_len || size > blob_len - offset)
+        {
+            return SSD1306_ERR_INVALID_ASSET_PACK;
+        }
+    }
+
+    pack->blob = blob;
+    pack->blob_len = blob_len;
+    pack->asset_count = asset_count;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_asset_pack_get(
+    const ssd1306_asset_pack_t* pack,
+    uint16_t asset_idx,
+    ssd1306_asset_t* asset
+)
+{
+    if(pack == NULL || asset == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(asset_idx >= pack->asset_count)
+    {
+        return SSD1306_ERR_INVALID_ASSET_IDX;
+    }
+
+    const uint8_t* entry = pack->blob + SSD1306_ASSET_PACK_HEADER_SIZE + asset_idx * SSD1306_ASSET_PACK_ENTRY_SIZE;
+
+    asset->data = pack->blob + ssd1306_asset_read_u32(entry);
+    asset->width = ssd1306_asset_read_u16(entry + 4);
+    asset->height = ssd1306_asset_read_u16(entry + 6);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_asset_stream(
+    const ssd1306_asset_t* asset,
+    uint8_t x,
+    uint8_t page
+)
+{
+    if(asset == NULL || asset->data == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(x >= SSD1306_WIDTH)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(page >= SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(asset->width == 0 || asset->height == 0)
+    {
+        return SSD1306_ERR_ZERO_LEN_DATA;
+    }
+
+    uint8_t window_page_start;
+    uint8_t window_page_count;
+    ssd1306_err_t error = ssd1306_get_row_window(&window_page_start, &window_page_count);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+    if(page < window_page_start || page >= window_page_start + window_page_count)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+
+    // Pages below the row window are not scanned by the panel
+    uint window_page_end = window_page_start + window_page_count;
+    uint page_count = (asset->height + SSD1306_PAGE_HEIGHT - 1) / SSD1306_PAGE_HEIGHT;
+    uint visible_pages = page_count < window_page_end - page ? page_count : window_page_end - page;
+    uint visible_cols = asset->width < SSD1306_WIDTH - x ? asset->width : SSD1306_WIDTH - x;
+
+    ssd1306_iovec_t rows[SSD1306_PAGE_COUNT];
+    size_t row_count;
+
+    if(visible_cols == asset->width)
+    {
+        // Unclipped rows are adjacent in the asset
+        rows[0].data = asset->data;
+        rows[0].len = visible_cols * visible_pages;
+        row_count = 1;
+    }
+    else
+    {
+        for(uint i = 0; i < visible_pages; ++i)
+        {
+            rows[i].data = asset->data + i * asset->width;
+            rows[i].len = visible_cols;
+        }
+
+        row_count = visible_pages;
+    }
+
+    return ssd1306_send_area_v(
+        page, page + visible_pages - 1,
+        x, x + visible_cols - 1,
+        rows, row_count
+    );
+}
+
+void ssd1306_asset_blit(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_asset_t* asset
+)
+{
+    ssd1306_gfx_draw_bitmap(canvas, x, y, asset->data, asset->width, asset->height);
+}
@@ -0,0 +1,124 @@
+/**
+ *
+ *  @file
+ *  @brief Flash-resident bitmap assets and asset packs
+ *
+ **/
+
+#ifndef SSD1306_ASSET_H
+#define SSD1306_ASSET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_ASSET_PACK_MAGIC
+ * @brief First 4 bytes of every asset pack.
+ *
+ * @def SSD1306_ASSET_PACK_HEADER_SIZE
+ * @brief Size of the asset pack header in bytes.
+ *
+ * @def SSD1306_ASSET_PACK_ENTRY_SIZE
+ * @brief Size of a single asset pack index entry in bytes.
+ */
+#define SSD1306_ASSET_PACK_MAGIC            "SSDA"
+#define SSD1306_ASSET_PACK_HEADER_SIZE      _u(8)
+#define SSD1306_ASSET_PACK_ENTRY_SIZE       _u(8)
+
+
+/**
+ * @struct ssd1306_asset_t
+ * @brief Page-major bitmap kept in flash, e.g. a const array executed in place (XIP).
+ * Bitmap bytes are only ever read, sequentially, so they are never copied to SRAM.
+ */
+typedef struct ssd1306_asset_t
+{
+    const uint8_t* data;    /**< Page-major bitmap data, width * ceil(height / 8) bytes. */
+    uint16_t width;         /**< Width in pixels. */
+    uint16_t height;        /**< Height in pixels. */
+}
+ssd1306_asset_t;
+
+/**
+ * @struct ssd1306_asset_pack_t
+ * @brief Indexed set of bitmaps stored in a single const blob.
+ *
+ * Blob layout, all numbers little-endian:
+ * - header: SSD1306_ASSET_PACK_MAGIC, uint16 asset count, uint16 reserved (0);
+ * - index: asset count entries of uint32 data offset from the blob start, uint16 width, uint16 height;
+ * - page-major bitmap data referenced by the index.
+ */
+typedef struct ssd1306_asset_pack_t
+{
+    const uint8_t* blob;    /**< Pack blob. */
+    size_t blob_len;        /**< Size of the pack blob in bytes. */
+    uint16_t asset_count;   /**< Number of assets in the index. */
+}
+ssd1306_asset_pack_t;
+
+
+/**
+ * @brief Opens an asset pack, validating its header and every index entry.
+ *
+ * @param pack Pointer to the pack to initialize.
+ * @param blob Pack blob.
+ * @param blob_len Size of the pack blob in bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_asset_pack_open(
+    ssd1306_asset_pack_t* pack,
+    const uint8_t blob[],
+    size_t blob_len
+);
+
+/**
+ * @brief Gets an asset from a pack. The asset points into the blob, nothing is copied.
+ *
+ * @param pack Pointer to the opened pack.
+ * @param asset_idx Asset index.
+ * @param asset Pointer to store the asset.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_asset_pack_get(
+    const ssd1306_asset_pack_t* pack,
+    uint16_t asset_idx,
+    ssd1306_asset_t* asset
+);
+
+/**
+ * @brief Streams an asset straight to display RAM at a page aligned position.
+ * Visible rows are gathered into one data transaction read from the asset in place.
+ * Whole pages are written, so bits below a partial last page are cleared.
+ * The asset is clipped by the display and its row window.
+ *
+ * @param asset Pointer to the asset.
+ * @param x Left column.
+ * @param page Top page, inside the row window.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_asset_stream(
+    const ssd1306_asset_t* asset,
+    uint8_t x,
+    uint8_t page
+);
+
+/**
+ * @brief Draws an asset into a canvas at any position, see ssd1306_gfx_draw_bitmap.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param asset Pointer to the asset.
+ */
+void ssd1306_asset_blit(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_asset_t* asset
+);
+
+
+#endif //SSD1306_ASSET_H
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_chart.h"
+
+
+static bool ssd1306_chart_is_shown(
+    const ssd1306_chart_t* chart,
+    uint8_t idx
+);
+static int ssd1306_chart_value_row(
+    const ssd1306_chart_t* chart,
+    int16_t value
+);
+static void ssd1306_chart_draw_col(
+    ssd1306_chart_t* chart,
+    int col,
+    uint8_t idx
+);
+static int ssd1306_chart_draw_label(
+    ssd1306_chart_t* chart,
+    bool is_redraw
+);
+static ssd1306_err_t ssd1306_chart_scroll_step(
+    const ssd1306_chart_t* chart
+);
+static ssd1306_err_t ssd1306_chart_flush_area(
+    const ssd1306_chart_t* chart,
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end
+);
+
+
+bool ssd1306_chart_is_shown(
+    const ssd1306_chart_t* chart,
+    uint8_t idx
+)
+{
+    bool is_stored = chart->sample_count == SSD1306_WIDTH || idx < chart->head;
+
+    // Sweep cursor column hides the oldest sample
+    return is_stored && !(chart->shift == SSD1306_CHART_SHIFT_SWEEP && idx == chart->head);
+}
+
+int ssd1306_chart_value_row(
+    const ssd1306_chart_t* chart,
+    int16_t value
+)
+{
+    int32_t range = chart->value_max - chart->value_min;
+    int32_t height = (chart->page_end - chart->page_start + 1) * SSD1306_PAGE_HEIGHT;
+    int32_t bottom = (chart->page_end + 1) * SSD1306_PAGE_HEIGHT - 1;
+
+    value = value < chart->value_min ? chart->value_min : value;
+    value = value > chart->value_max ? chart->value_max : value;
+
+    return bottom - ((value - chart->value_min) * (height - 1) + range / 2) / range;
+}
+
+void ssd1306_chart_draw_col(
+    ssd1306_chart_t* chart,
+    int col,
+    uint8_t idx
+)
+{
+    int top = chart->page_start * SSD1306_PAGE_HEIGHT;
+    int height = (chart->page_end - chart->page_start + 1) * SSD1306_PAGE_HEIGHT;
+
+    ssd1306_gfx_fill_rect(chart->canvas, col, top, 1, height, false);
+
+    if(!ssd1306_chart_is_shown(chart, idx))
+    {
+        return;
+    }
+
+    uint8_t prev_idx = (idx + SSD1306_WIDTH - 1) % SSD1306_WIDTH;
+    uint8_t oldest_idx = chart->sample_count == SSD1306_WIDTH ? chart->head : 0;
+    int y = ssd1306_chart_value_row(chart, chart->samples[idx]);
+    int y_start = y;
+    int y_end = y;
+
+    // Column joins the previous sample, the row of which is already drawn in the previous column
+    if(idx != oldest_idx && ssd1306_chart_is_shown(chart, prev_idx))
+    {
+        int prev_y = ssd1306_chart_value_row(chart, chart->samples[prev_idx]);
+
+        y_start = prev_y < y ? prev_y + 1 : y;
+        y_end = prev_y > y ? prev_y - 1 : y;
+    }
+
+    ssd1306_gfx_fill_rect(chart->canvas, col, y_start, 1, y_end - y_start + 1, true);
+}
+
+int ssd1306_chart_draw_label(
+    ssd1306_chart_t* chart,
+    bool is_redraw
+)
+{
+    char label[SSD1306_CHART_LABEL_LEN];
+    uint8_t newest_idx = (chart->head + SSD1306_WIDTH - 1) % SSD1306_WIDTH;
+
+    if(chart->sample_count > 0)
+    {
+        snprintf(label, sizeof(label), "%d", chart->samples[newest_idx]);
+    }
+    else
+    {
+        label[0] = '\0';
+    }
+
+    size_t len = strlen(label);
+    size_t prev_len = strlen(chart->label);
+    size_t max_len = len > prev_len ? len : prev_len;
+    int changed_col = SSD1306_WIDTH;
+
+    // Labels are right aligned, so glyphs are compared from the right
+    for(size_t i = 1; i <= max_len; ++i)
+    {
+        char glyph = i <= len ? label[len - i] : ' ';
+        char prev_glyph = i <= prev_len ? chart->label[prev_len - i] : ' ';
+
+        if(glyph != prev_glyph)
+        {
+            changed_col = SSD1306_WIDTH - i * chart->font->glyph_width;
+        }
+    }
+
+    changed_col = changed_col < 0 ? 0 : changed_col;
+    changed_col = is_redraw ? 0 : changed_col;
+
+    if(changed_col < SSD1306_WIDTH)
+    {
+        ssd1306_gfx_fill_rect(chart->canvas, changed_col, chart->label_page * SSD1306_PAGE_HEIGHT, SSD1306_WIDTH - changed_col, SSD1306_PAGE_HEIGHT, false);
+        ssd1306_gfx_draw_str(chart->canvas, SSD1306_WIDTH - len * chart->font->glyph_width, chart->label_page * SSD1306_PAGE_HEIGHT, chart->font, label);
+    }
+
+    memcpy(chart->label, label, sizeof(label));
+
+    return changed_col;
+}
+
+ssd1306_err_t ssd1306_chart_scroll_step(
+    const ssd1306_chart_t* chart
+)
+{
+    // One column content scroll moves display RAM by exactly the column the canvas was moved by, whatever the frame timing
+    return ssd1306_content_scroll_left(chart->page_start, chart->page_end);
+}
+
+ssd1306_err_t ssd1306_chart_flush_area(
+    const ssd1306_chart_t* chart,
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end
+)
+{
+    uint8_t window_page_start;
+    uint8_t window_page_count;
+    ssd1306_err_t error = ssd1306_get_row_window(&window_page_start, &window_page_count);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    // Canvas covers the whole display, flushes take the frame of the row window
+    return ssd1306_flush_area(chart->canvas->buffer + window_page_start * SSD1306_WIDTH, page_start, page_end, col_start, col_end);
+}
+
+ssd1306_err_t ssd1306_chart_init(
+    ssd1306_chart_t* chart,
+    ssd1306_canvas_t* canvas,
+    ssd1306_chart_shift_t shift,
+    uint8_t page_start,
+    uint8_t page_end,
+    int16_t value_min,
+    int16_t value_max
+)
+{
+    if(chart == NULL || canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(canvas->width != SSD1306_WIDTH || canvas->height != SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_CANVAS_SIZE;
+    }
+    if(shift >= SSD1306_CHART_SHIFT_COUNT)
+    {
+        return SSD1306_ERR_INVALID_CHART_SHIFT;
+    }
+    if(page_start >= SSD1306_PAGE_COUNT || page_end >= SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(page_start > page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE_BOUNDS;
+    }
+    if(value_min >= value_max)
+    {
+        return SSD1306_ERR_INVALID_CHART_RANGE;
+    }
+
+    memset(chart, 0, sizeof(ssd1306_chart_t));
+
+    chart->canvas = canvas;
+    chart->shift = shift;
+    chart->page_start = page_start;
+    chart->page_end = page_end;
+    chart->value_min = value_min;
+    chart->value_max = value_max;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_chart_set_label(
+    ssd1306_chart_t* chart,
+    const ssd1306_font_t* font,
+    uint8_t label_page
+)
+{
+    if(chart == NULL || font == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(label_page >= SSD1306_PAGE_COUNT || (label_page >= chart->page_start && label_page <= chart->page_end))
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+
+    chart->font = font;
+    chart->label_page = label_page;
+    chart->label[0] = '\0';
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_chart_redraw(
+    ssd1306_chart_t* chart
+)
+{
+    if(chart == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    for(int col = 0; col < SSD1306_WIDTH; ++col)
+    {
+        // Newest sample is the right column in scroll mode
+        uint8_t idx = chart->shift == SSD1306_CHART_SHIFT_SCROLL ? (chart->head + col) % SSD1306_WIDTH : col;
+
+        ssd1306_chart_draw_col(chart, col, idx);
+    }
+
+    ssd1306_err_t error = ssd1306_chart_flush_area(chart, chart->page_start, chart->page_end, 0, SSD1306_WIDTH - 1);
+
+    if(error == SSD1306_ERR_OK && chart->font != NULL)
+    {
+        ssd1306_chart_draw_label(chart, true);
+        error = ssd1306_chart_flush_area(chart, chart->label_page, chart->label_page, 0, SSD1306_WIDTH - 1);
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_chart_push(
+    ssd1306_chart_t* chart,
+    int16_t value
+)
+{
+    if(chart == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint8_t idx = chart->head;
+    ssd1306_err_t error = SSD1306_ERR_OK;
+
+    chart->samples[idx] = value;
+    chart->head = (idx + 1) % SSD1306_WIDTH;
+    chart->sample_count += chart->sample_count < SSD1306_WIDTH;
+
+    if(chart->shift == SSD1306_CHART_SHIFT_SCROLL)
+    {
+        // Same move as the controller scroll, the left column wraps around and is overwritten
+        for(uint8_t page = chart->page_start; page <= chart->page_end; ++page)
+        {
+            uint8_t* row = &chart->canvas->buffer[page * SSD1306_WIDTH];
+
+            memmove(row, row + 1, SSD1306_WIDTH - 1);
+        }
+
+        ssd1306_chart_draw_col(chart, SSD1306_WIDTH - 1, idx);
+
+        error = ssd1306_chart_scroll_step(chart);
+
+        if(error == SSD1306_ERR_OK)
+        {
+            error = ssd1306_chart_flush_area(chart, chart->page_start, chart->page_end, SSD1306_WIDTH - 1, SSD1306_WIDTH - 1);
+        }
+    }
+    else
+    {
+        ssd1306_chart_draw_col(chart, idx, idx);
+        ssd1306_chart_draw_col(chart, chart->head, chart->head);
+
+        // Cursor column wraps to the left edge after the last column
+        error = ssd1306_chart_flush_area(chart, chart->page_start, chart->page_end, idx, chart->head > idx ? chart->head : idx);
+
+        if(error == SSD1306_ERR_OK && chart->head < idx)
+        {
+            error = ssd1306_chart_flush_area(chart, chart->page_start, chart->page_end, chart->head, chart->head);
+        }
+    }
+
+    if(error == SSD1306_ERR_OK && chart->font != NULL)
+    {
+        int changed_col = ssd1306_chart_draw_label(chart, false);
+
+        if(changed_col < SSD1306_WIDTH)
+        {
+            error = ssd1306_chart_flush_area(chart, chart->label_page, chart->label_page, changed_col, SSD1306_WIDTH - 1);
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,124 @@
+/**
+ *
+ *  @file
+ *  @brief Strip chart of a rolling time series sending one column per sample
+ *
+ **/
+
+#ifndef SSD1306_CHART_H
+#define SSD1306_CHART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_CHART_LABEL_LEN
+ * @brief Size of the value label text, null terminator included.
+ */
+#define SSD1306_CHART_LABEL_LEN             _u(8)
+
+
+/**
+ * @enum ssd1306_chart_shift_t
+ * @brief How a chart makes room for a new sample.
+ */
+typedef enum ssd1306_chart_shift_t
+{
+    SSD1306_CHART_SHIFT_SCROLL,     /**< Chart pages are moved left by a one column content scroll, the new sample is the right column. */
+    SSD1306_CHART_SHIFT_SWEEP,      /**< Nothing moves, the new sample overwrites the oldest column and a blank cursor column follows it. */
+    SSD1306_CHART_SHIFT_COUNT,      /**< Total number of valid values. */
+} ssd1306_chart_shift_t;
+
+/**
+ * @struct ssd1306_chart_t
+ * @brief Full width chart over a range of pages of a display sized canvas, one sample per column.
+ *
+ * Canvas is kept equal to display RAM, so a sample costs the bytes of one column (two in sweep mode) plus
+ * the changed glyphs of the value label, instead of the whole chart. In scroll mode the chart pages of the
+ * canvas are shifted in RAM the same way the controller shifts its own RAM.
+ * Chart pages are sent as partial areas, so the next ssd1306_flush sends them once.
+ */
+typedef struct ssd1306_chart_t
+{
+    ssd1306_canvas_t* canvas;               /**< Display sized canvas mirroring display RAM. */
+    ssd1306_chart_shift_t shift;            /**< Shift mode. */
+    uint8_t page_start;                     /**< First page of the chart. */
+    uint8_t page_end;                       /**< Last page of the chart. */
+    int16_t value_min;                      /**< Value shown at the bottom row, lower values are clamped. */
+    int16_t value_max;                      /**< Value shown at the top row, higher values are clamped. */
+    int16_t samples[SSD1306_WIDTH];         /**< Ring of samples, in sweep mode the ring index is the column. */
+    uint8_t head;                           /**< Ring index of the next sample. */
+    uint8_t sample_count;                   /**< Number of samples stored, at most SSD1306_WIDTH. */
+    const ssd1306_font_t* font;             /**< Font of the value label or NULL if there is no label. */
+    uint8_t label_page;                     /**< Page of the value label. */
+    char label[SSD1306_CHART_LABEL_LEN];    /**< Shown value label text, right aligned. */
+}
+ssd1306_chart_t;
+
+
+/**
+ * @brief Initializes an empty chart without a value label. Nothing is drawn until ssd1306_chart_redraw.
+ *
+ * @param chart Pointer to the chart to initialize.
+ * @param canvas Pointer to a canvas of SSD1306_WIDTH x SSD1306_HEIGHT pixels.
+ * @param shift Shift mode.
+ * @param page_start First page of the chart.
+ * @param page_end Last page of the chart.
+ * @param value_min Value shown at the bottom row.
+ * @param value_max Value shown at the top row, greater than value_min.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_chart_init(
+    ssd1306_chart_t* chart,
+    ssd1306_canvas_t* canvas,
+    ssd1306_chart_shift_t shift,
+    uint8_t page_start,
+    uint8_t page_end,
+    int16_t value_min,
+    int16_t value_max
+);
+
+/**
+ * @brief Shows the newest value right aligned on a page outside the chart. Shown on the next redraw.
+ *
+ * @param chart Pointer to the chart.
+ * @param font Pointer to the label font.
+ * @param label_page Page of the label, outside the chart pages.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_chart_set_label(
+    ssd1306_chart_t* chart,
+    const ssd1306_font_t* font,
+    uint8_t label_page
+);
+
+/**
+ * @brief Draws all samples and the label into the canvas and sends the chart and label pages.
+ * Needed once after initialization and whenever the canvas was drawn over the chart.
+ *
+ * @param chart Pointer to the chart.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_chart_redraw(
+    ssd1306_chart_t* chart
+);
+
+/**
+ * @brief Adds a sample, dropping the oldest one once the chart is full, and sends only what changed.
+ * Scroll mode moves display RAM with ssd1306_content_scroll_left, so it never waits for the controller.
+ *
+ * @param chart Pointer to the chart.
+ * @param value New sample.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_chart_push(
+    ssd1306_chart_t* chart,
+    int16_t value
+);
+
+
+#endif //SSD1306_CHART_H
@@ -0,0 +1,197 @@
+#include <string.h>
+
+#include "ssd1306_dither.h"
+
+
+static void ssd1306_dither_put(
+    uint8_t page_row[],
+    int x,
+    uint8_t bit,
+    bool is_on
+);
+
+
+static const uint8_t ssd1306_dither_bayer[8][8] = {
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+
+void ssd1306_dither_put(
+    uint8_t page_row[],
+    int x,
+    uint8_t bit,
+    bool is_on
+)
+{
+    if(is_on)
+    {
+        page_row[x] |= bit;
+    }
+    else
+    {
+        page_row[x] &= ~bit;
+    }
+}
+
+ssd1306_err_t ssd1306_dither_init(
+    ssd1306_dither_t* dither,
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    uint16_t width,
+    ssd1306_dither_mode_t mode,
+    int16_t errors[],
+    size_t errors_len
+)
+{
+    if(dither == NULL || canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(width == 0)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(mode >= SSD1306_DITHER_MODE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_DITHER_MODE;
+    }
+    if(mode == SSD1306_DITHER_FLOYD_STEINBERG)
+    {
+        if(errors == NULL)
+        {
+            return SSD1306_ERR_NULL_DATA;
+        }
+        if(errors_len < SSD1306_DITHER_ERROR_BUFF_LEN(width))
+        {
+            return SSD1306_ERR_INVALID_BUFF_SIZE;
+        }
+
+        memset(errors, 0, SSD1306_DITHER_ERROR_BUFF_LEN(width) * sizeof(int16_t));
+    }
+
+    dither->canvas = canvas;
+    dither->x = x;
+    dither->y = y;
+    dither->width = width;
+    dither->mode = mode;
+    dither->threshold = 0x7F;
+    dither->errors = errors;
+
+    return SSD1306_ERR_OK;
+}
+
+void ssd1306_dither_row(
+    ssd1306_dither_t* dither,
+    const uint8_t row[]
+)
+{
+    ssd1306_canvas_t* canvas = dither->canvas;
+    int y = dither->y++;
+    const ssd1306_clip_t* clip = &canvas->clip;
+    bool is_visible = y >= clip->y_start && y < clip->y_end;
+
+    // Image columns covering the clip rectangle
+    int col_start = dither->x < clip->x_start ? clip->x_start - dither->x : 0;
+    int col_end = clip->x_end - dither->x < dither->width ? clip->x_end - dither->x : dither->width;
+
+    uint8_t* page_row = NULL;
+    uint8_t bit = 0;
+
+    if(is_visible)
+    {
+        page_row = canvas->buffer + (y / SSD1306_PAGE_HEIGHT) * canvas->width + dither->x;
+        bit = 1 << (y % SSD1306_PAGE_HEIGHT);
+    }
+
+    switch(dither->mode)
+    {
+        case SSD1306_DITHER_THRESHOLD:
+            for(int col = col_start; is_visible && col < col_end; ++col)
+            {
+                ssd1306_dither_put(page_row, col, bit, row[col] > dither->threshold);
+            }
+            break;
+
+        case SSD1306_DITHER_BAYER:
+        {
+            const uint8_t* bayer_row = ssd1306_dither_bayer[y & 7];
+
+            for(int col = col_start; is_visible && col < col_end; ++col)
+            {
+                uint8_t threshold = bayer_row[(dither->x + col) & 7] * 4 + 2;
+                ssd1306_dither_put(page_row, col, bit, row[col] > threshold);
+            }
+            break;
+        }
+
+        default:
+        {
+            // Error terms are kept in 1/16 units with a guard term on both sides of every row
+            int16_t* errors = dither->errors + (y & 1) * (dither->width + 2) + 1;
+            int16_t* next_errors = dither->errors + (~y & 1) * (dither->width + 2) + 1;
+            int carry = 0;
+
+            memset(next_errors - 1, 0, (dither->width + 2) * sizeof(int16_t));
+
+            // Clipped columns still diffuse their error, so clipping doesn't change the visible part
+            for(int col = 0; col < dither->width; ++col)
+            {
+                int value = row[col] + (errors[col] + carry) / 16;
+                bool is_on = value > 0x7F;
+                int error = is_on ? value - 0xFF : value;
+
+                if(is_visible && col >= col_start && col < col_end)
+                {
+                    ssd1306_dither_put(page_row, col, bit, is_on);
+                }
+
+                carry = error * 7;
+                next_errors[col - 1] += error * 3;
+                next_errors[col] += error * 5;
+                next_errors[col + 1] += error;
+            }
+            break;
+        }
+    }
+}
+
+ssd1306_err_t ssd1306_dither_image(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t pixels[],
+    uint16_t width,
+    uint16_t height,
+    ssd1306_dither_mode_t mode,
+    int16_t errors[],
+    size_t errors_len
+)
+{
+    if(pixels == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    ssd1306_dither_t dither;
+    ssd1306_err_t error = ssd1306_dither_init(&dither, canvas, x, y, width, mode, errors, errors_len);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    for(uint16_t i = 0; i < height; ++i)
+    {
+        ssd1306_dither_row(&dither, pixels + i * width);
+    }
+
+    return SSD1306_ERR_OK;
+}
@@ -0,0 +1,117 @@
+/**
+ *
+ *  @file
+ *  @brief Grayscale image conversion into page-major framebuffers
+ *
+ **/
+
+#ifndef SSD1306_DITHER_H
+#define SSD1306_DITHER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_DITHER_ERROR_BUFF_LEN
+ * @brief Number of error terms needed by Floyd-Steinberg dithering of an image width pixels wide.
+ */
+#define SSD1306_DITHER_ERROR_BUFF_LEN(width)    (2 * ((width) + 2))
+
+
+/**
+ * @enum ssd1306_dither_mode_t
+ * @brief Conversion of 8-bit gray to 1 bpp.
+ */
+typedef enum ssd1306_dither_mode_t
+{
+    SSD1306_DITHER_THRESHOLD,           /**< Pixels brighter than the threshold are on. */
+    SSD1306_DITHER_BAYER,               /**< Ordered dithering with an 8x8 Bayer matrix, anchored to the canvas. */
+    SSD1306_DITHER_FLOYD_STEINBERG,     /**< Error diffusion, needs an error buffer. */
+    SSD1306_DITHER_MODE_COUNT,          /**< Total number of valid values. */
+} ssd1306_dither_mode_t;
+
+/**
+ * @struct ssd1306_dither_t
+ * @brief Streaming converter of row-major 8-bit gray rows into a canvas.
+ * Rows are converted as they arrive, e.g. from a network buffer, so the whole image never has to be stored.
+ */
+typedef struct ssd1306_dither_t
+{
+    ssd1306_canvas_t* canvas;       /**< Destination canvas. */
+    int x;                          /**< Left column of the image. */
+    int y;                          /**< Row of the next image row. */
+    uint16_t width;                 /**< Image width in pixels. */
+    ssd1306_dither_mode_t mode;     /**< Conversion mode. */
+    uint8_t threshold;              /**< Threshold of SSD1306_DITHER_THRESHOLD mode. */
+    int16_t* errors;                /**< Error terms of the current and the next row, Floyd-Steinberg only. */
+}
+ssd1306_dither_t;
+
+
+/**
+ * @brief Initializes a streaming converter.
+ *
+ * @param dither Pointer to the converter to initialize.
+ * @param canvas Destination canvas.
+ * @param x Left column of the image.
+ * @param y Top row of the image.
+ * @param width Image width in pixels.
+ * @param mode Conversion mode.
+ * @param errors Buffer of SSD1306_DITHER_ERROR_BUFF_LEN(width) error terms, may be NULL unless Floyd-Steinberg is used.
+ * @param errors_len Number of error terms in the buffer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_dither_init(
+    ssd1306_dither_t* dither,
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    uint16_t width,
+    ssd1306_dither_mode_t mode,
+    int16_t errors[],
+    size_t errors_len
+);
+
+/**
+ * @brief Converts the next image row into the canvas. The image is clipped by the clip rectangle of the canvas.
+ *
+ * @param dither Pointer to the converter.
+ * @param row Row of width 8-bit gray pixels, 0 is black.
+ */
+void ssd1306_dither_row(
+    ssd1306_dither_t* dither,
+    const uint8_t row[]
+);
+
+/**
+ * @brief Converts a whole row-major 8-bit gray image into the canvas, see ssd1306_dither_row.
+ *
+ * @param canvas Destination canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param pixels Image pixels, width * height bytes.
+ * @param width Image width in pixels.
+ * @param height Image height in pixels.
+ * @param mode Conversion mode.
+ * @param errors Buffer of SSD1306_DITHER_ERROR_BUFF_LEN(width) error terms, may be NULL unless Floyd-Steinberg is used.
+ * @param errors_len Number of error terms in the buffer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_dither_image(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t pixels[],
+    uint16_t width,
+    uint16_t height,
+    ssd1306_dither_mode_t mode,
+    int16_t errors[],
+    size_t errors_len
+);
+
+
+#endif //SSD1306_DITHER_H
@@ -1,22 +1,15 @@
 #include <string.h>
-#include <stdlib.h>
 #include <pico/stdlib.h>
 #include <pico/binary_info.h>
 #include <hardware/gpio.h>
+#include <hardware/dma.h>
+#if PICO_ON_DEVICE
+#include <pico/mutex.h>
+#endif
 
 
 #include "ssd1306_driver.h"
 
-typedef struct ssd1306_ctx_t
-{
-    i2c_inst_t* i2c_instance;
-    uint8_t i2c_address;
-    uint sda_pin;
-    uint scl_pin;
-    bool is_init;
-} 
-ssd1306_ctx_t;
-
 typedef enum ssd1306_i2c_header_t
 {
     SSD1306_I2C_HEADER_DATA = _u(0x40),
@@ -69,6 +62,8 @@ typedef enum ssd1306_cmd_t
     SSD1306_CMD_HSCROL_LEFT                    = _u(0x27),
     SSD1306_CMD_VHSCROL_RIGHT                  = _u(0x29),
     SSD1306_CMD_VHSCROL_LEFT                   = _u(0x2A),
+    SSD1306_CMD_CONTENT_SCROLL_RIGHT           = _u(0x2C),
+    SSD1306_CMD_CONTENT_SCROLL_LEFT            = _u(0x2D),
     SSD1306_CMD_SCROLLL_OFF                    = _u(0x2E),
     SSD1306_CMD_SCROLLL_ON                     = _u(0x2F),
     SSD1306_CMD_SET_VSCROLL_AREA               = _u(0xA3),
@@ -97,8 +92,25 @@ typedef enum ssd1306_cmd_t
 ssd1306_cmd_t;
 
 
+static void ssd1306_init_ctx();
+static void ssd1306_apply_i2c_clk_freq(
+    uint freq_khz
+);
+static ssd1306_err_t ssd1306_i2c_hw_writev(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count,
+    size_t buffer_len
+);
+static ssd1306_err_t ssd1306_i2c_writev_once(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+static ssd1306_err_t ssd1306_i2c_writev(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
 static ssd1306_err_t ssd1306_i2c_write(
-    uint8_t buffer[], 
+    const uint8_t buffer[], 
     size_t buffer_len
 );
 static ssd1306_err_t ssd1306_send_cmd(
@@ -106,6 +118,51 @@ static ssd1306_err_t ssd1306_send_cmd(
     uint8_t cmd_optios[], 
     size_t cmd_optios_len
 );
+static ssd1306_err_t ssd1306_write_ram(
+    const uint8_t data[], 
+    size_t data_len
+);
+static ssd1306_err_t ssd1306_write_ram_v(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+static ssd1306_err_t ssd1306_write_ram_prefixed(
+    uint8_t buffer[], 
+    size_t data_len
+);
+static ssd1306_err_t ssd1306_flush_pages(
+    const uint8_t frame[],
+    uint8_t prefixed_frame[]
+);
+static uint8_t ssd1306_get_changed_pages(
+    const uint8_t frame[],
+    uint32_t page_crc[]
+);
+static ssd1306_err_t ssd1306_flush_run(
+    const uint8_t frame[],
+    uint8_t prefixed_frame[],
+    uint8_t page_start,
+    uint8_t page_end,
+    const uint32_t page_crc[]
+);
+static void ssd1306_update_frame_timing();
+static uint8_t ssd1306_get_window_offset(
+    ssd1306_orientation_t orientation
+);
+static uint ssd1306_time_hist_bucket(
+    uint64_t time_us
+);
+static void ssd1306_record_flush(
+    uint64_t start_us
+);
+static uint32_t ssd1306_crc32(
+    const uint8_t data[], 
+    size_t data_len
+);
+static ssd1306_err_t ssd1306_send_cmd_list(
+    const uint8_t cmds[],
+    size_t cmds_len
+);
 static ssd1306_err_t ssd1306_h_scroll_common_setup(
     ssd1306_cmd_t cmd,
     uint8_t page_start,
@@ -119,6 +176,14 @@ static ssd1306_err_t ssd1306_vh_scroll_common_setup(
     ssd1306_scroll_freq_t scroll_freq,
     uint8_t row_offset
 );
+static ssd1306_err_t ssd1306_content_scroll_common(
+    ssd1306_cmd_t cmd,
+    uint8_t page_start,
+    uint8_t page_end
+);
+static ssd1306_err_t ssd1306_set_base_remap(
+    ssd1306_cmd_t cmd
+);
 static ssd1306_err_t ssd1306_set_mem_mode(
     ssd1306_mem_mode_t mem_mode
 );
@@ -133,7 +198,18 @@ static ssd1306_err_t ssd1306_set_charge_pump_mode(
 );
 
 
-ssd1306_ctx_t ssd1306_ctx = {};
+// Staging buffer is only needed by contiguous transports, so it is passed to ssd1306_init_transport
+ssd1306_instance_t ssd1306_default_ctx = {};
+
+// Instance selected by ssd1306_select_instance on every core, so each core can drive its own display
+ssd1306_instance_t* ssd1306_core_ctx[NUM_CORES] = { &ssd1306_default_ctx, &ssd1306_default_ctx };
+
+#define ssd1306_ctx     (ssd1306_core_ctx[get_core_num()])
+
+#if PICO_ON_DEVICE
+// DMA sniffer is a single peripheral shared by the channels of all instances on both cores
+auto_init_mutex(ssd1306_crc_sniffer_mutex);
+#endif
 
 ssd1306_err_t ssd1306_init_i2c(
     i2c_inst_t* i2c_instance,  
@@ -141,7 +217,7 @@ ssd1306_err_t ssd1306_init_i2c(
     uint scl_pin
 )
 {
-    if(ssd1306_ctx.is_init)
+    if(ssd1306_ctx->is_init)
     {
         return SSD1306_ERR_INITIALIZED;
     }
@@ -162,12 +238,10 @@ ssd1306_err_t ssd1306_init_i2c(
         return SSD1306_ERR_INVALID_SCL_PIN;
     }
 
-    memset(&ssd1306_ctx, 0, sizeof(ssd1306_ctx_t));
-    ssd1306_ctx.i2c_instance = i2c_instance;
-    ssd1306_ctx.i2c_address = SSD1306_I2C_ADDRESS;
-    ssd1306_ctx.sda_pin = sda_pin;
-    ssd1306_ctx.sda_pin = scl_pin;
-    ssd1306_ctx.is_init = true;
+    ssd1306_init_ctx();
+    ssd1306_ctx->i2c_instance = i2c_instance;
+    ssd1306_ctx->sda_pin = sda_pin;
+    ssd1306_ctx->scl_pin = scl_pin;
 
     i2c_init(i2c_instance, SSD1306_I2C_CLK_FREQ_KHZ * 1000);
 
@@ -180,110 +254,1382 @@ ssd1306_err_t ssd1306_init_i2c(
     return SSD1306_ERR_OK;
 }
 
+ssd1306_err_t ssd1306_init_transport(
+    ssd1306_transport_write_t write,
+    void* user_data,
+    uint8_t staging_buffer[],
+    size_t staging_buffer_len
+)
+{
+    if(ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_INITIALIZED;
+    }
+    if(write == NULL || staging_buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(staging_buffer_len < SSD1306_STAGING_BUFF_SIZE)
+    {
+        return SSD1306_ERR_INVALID_BUFF_SIZE;
+    }
+
+    ssd1306_init_ctx();
+    ssd1306_ctx->transport_write = write;
+    ssd1306_ctx->transport_user_data = user_data;
+    ssd1306_ctx->staging_buffer = staging_buffer;
+    ssd1306_ctx->staging_buffer_len = staging_buffer_len;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_init_transport_v(
+    ssd1306_transport_writev_t writev,
+    void* user_data
+)
+{
+    if(ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_INITIALIZED;
+    }
+    if(writev == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    ssd1306_init_ctx();
+    ssd1306_ctx->transport_writev = writev;
+    ssd1306_ctx->transport_user_data = user_data;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_select_instance(
+    ssd1306_instance_t* instance
+)
+{
+    ssd1306_core_ctx[get_core_num()] = instance != NULL ? instance : &ssd1306_default_ctx;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_set_flush_hook(
+    ssd1306_flush_hook_t hook,
+    void* user_data
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    ssd1306_ctx->flush_hook = hook;
+    ssd1306_ctx->flush_hook_user_data = user_data;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_instance_t* ssd1306_get_instance()
+{
+    return ssd1306_ctx;
+}
+
+void ssd1306_init_ctx()
+{
+    memset(ssd1306_ctx, 0, sizeof(ssd1306_instance_t));
+    ssd1306_ctx->i2c_address = SSD1306_I2C_ADDRESS;
+    ssd1306_ctx->i2c_clk_freq_khz = SSD1306_I2C_CLK_FREQ_KHZ;
+    ssd1306_ctx->is_clk_fallback_on = true;
+    ssd1306_ctx->power_state = SSD1306_POWER_STATE_OFF;
+    ssd1306_ctx->is_base_seg_remap_on = true;
+    ssd1306_ctx->is_base_com_out_scan_remap_on = true;
+    ssd1306_ctx->orientation = SSD1306_ORIENTATION_0;
+    ssd1306_ctx->window_page_start = 0;
+    ssd1306_ctx->window_page_count = SSD1306_PAGE_COUNT;
+    ssd1306_ctx->mux_ratio = SSD1306_HEIGHT - 1;
+    ssd1306_ctx->display_start_line = 0;
+    ssd1306_ctx->dclk_config = (SSD1306_DEFAULT_OSC_FREQ_LEVEL << 4) | SSD1306_DEFAULT_DCLK_DIV_RATIO;
+    ssd1306_ctx->precharge_config = (SSD1306_DEFAULT_PRECHARGE_PHASE_PERIOD << 4) | SSD1306_DEFAULT_PRECHARGE_PHASE_PERIOD;
+    ssd1306_ctx->is_frame_period_calibrated = false;
+    ssd1306_ctx->is_ram_valid = false;
+    ssd1306_ctx->page_crc_valid_mask = 0;
+    ssd1306_ctx->crc_dma_channel = -1;
+    ssd1306_ctx->is_init = true;
+
+    ssd1306_update_frame_timing();
+
+#if PICO_ON_DEVICE
+    // Without a free channel CRCs fall back to software
+    ssd1306_ctx->crc_dma_channel = dma_claim_unused_channel(false);
+#endif
+}
+
 ssd1306_err_t ssd1306_deinit_i2c()
 {
-    if(!ssd1306_ctx.is_init)
+    if(!ssd1306_ctx->is_init)
     {
         return SSD1306_ERR_DEINITIALIZED;
     }
 
-    i2c_deinit(ssd1306_ctx.i2c_instance);
-    gpio_deinit(ssd1306_ctx.scl_pin);
-    gpio_deinit(ssd1306_ctx.sda_pin);
+    if(ssd1306_ctx->crc_dma_channel >= 0)
+    {
+        dma_channel_unclaim(ssd1306_ctx->crc_dma_channel);
+    }
+
+    if(ssd1306_ctx->i2c_instance != NULL)
+    {
+        i2c_deinit(ssd1306_ctx->i2c_instance);
+        gpio_deinit(ssd1306_ctx->scl_pin);
+        gpio_deinit(ssd1306_ctx->sda_pin);
+    }
 
-    memset(&ssd1306_ctx, 0, sizeof(ssd1306_ctx_t));
+    memset(ssd1306_ctx, 0, sizeof(ssd1306_instance_t));
 
     return SSD1306_ERR_OK;
 }
 
-ssd1306_err_t ssd1306_i2c_write(
-    uint8_t buffer[], 
-    size_t buffer_len
+ssd1306_err_t ssd1306_set_i2c_clk_freq(
+    uint freq_khz
 )
 {
-    int write_res = i2c_write_blocking(i2c_default, ssd1306_ctx.i2c_address, buffer, buffer_len, false);
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(freq_khz < SSD1306_I2C_MIN_CLK_FREQ_KHZ || freq_khz > SSD1306_I2C_MAX_CLK_FREQ_KHZ)
+    {
+        return SSD1306_ERR_INVALID_I2C_CLK_FREQ;
+    }
 
-    switch (write_res)
+    ssd1306_apply_i2c_clk_freq(freq_khz);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_get_i2c_clk_freq(
+    uint* freq_khz
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(freq_khz == NULL)
     {
-        case PICO_ERROR_TIMEOUT:
-            return SSD1306_ERR_PICO_I2C_TIMEOUT;
-        case PICO_ERROR_GENERIC:
-            return SSD1306_ERR_PICO_ERROR_GENERIC;
-        default:
-            return SSD1306_ERR_OK;
+        return SSD1306_ERR_NULL_DATA;
     }
+
+    *freq_khz = ssd1306_ctx->i2c_clk_freq_khz;
+
+    return SSD1306_ERR_OK;
 }
 
-ssd1306_err_t ssd1306_send_cmd(
-    ssd1306_cmd_t cmd,
-    uint8_t cmd_optios[], 
-    size_t cmd_optios_len
+ssd1306_err_t ssd1306_calibrate_i2c_clk(
+    uint freq_max_khz
 )
 {
-    if(!ssd1306_ctx.is_init)
+    if(!ssd1306_ctx->is_init)
     {
         return SSD1306_ERR_DEINITIALIZED;
     }
+    if(freq_max_khz < SSD1306_I2C_MIN_CLK_FREQ_KHZ || freq_max_khz > SSD1306_I2C_MAX_CLK_FREQ_KHZ)
+    {
+        return SSD1306_ERR_INVALID_I2C_CLK_FREQ;
+    }
 
-    size_t write_buffer_len = cmd_optios_len + 2;
-    uint8_t* write_buffer = (uint8_t*)calloc(write_buffer_len, sizeof(uint8_t));
-    
-    write_buffer[0] = (uint8_t)SSD1306_I2C_HEADER_CMD;
-    write_buffer[1] = (uint8_t)cmd;
+    // The SSD1306 can't be read back over I2C, so every byte of the pattern
+    // is verified by its ACK. NOP commands keep the display state intact.
+    uint8_t probe_buffer[32];
+    memset(probe_buffer, SSD1306_CMD_NO_OPERATION, sizeof(probe_buffer));
+    probe_buffer[0] = (uint8_t)SSD1306_I2C_HEADER_CMD;
+
+    const ssd1306_iovec_t probe_segment = { probe_buffer, sizeof(probe_buffer) };
+
+    uint initial_freq_khz = ssd1306_ctx->i2c_clk_freq_khz;
+    uint reliable_freq_khz = 0;
+
+    for(uint freq_khz = SSD1306_I2C_MIN_CLK_FREQ_KHZ; freq_khz <= freq_max_khz; freq_khz += SSD1306_I2C_CLK_FREQ_STEP_KHZ)
+    {
+        ssd1306_apply_i2c_clk_freq(freq_khz);
 
-    if(cmd_optios != NULL)
+        bool is_reliable = true;
+
+        for(uint i = 0; i < SSD1306_I2C_CALIB_PROBE_COUNT && is_reliable; ++i)
+        {
+            is_reliable = ssd1306_i2c_writev_once(&probe_segment, 1) == SSD1306_ERR_OK;
+        }
+
+        if(!is_reliable)
+        {
+            break;
+        }
+
+        reliable_freq_khz = freq_khz;
+    }
+
+    if(reliable_freq_khz == 0)
     {
-        memcpy(write_buffer + 2, cmd_optios, cmd_optios_len);
+        ssd1306_apply_i2c_clk_freq(initial_freq_khz);
+        return SSD1306_ERR_I2C_CALIBRATION_FAILED;
+    }
+
+    ssd1306_apply_i2c_clk_freq(reliable_freq_khz);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_set_i2c_clk_fallback(
+    bool is_enabled
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    ssd1306_ctx->is_clk_fallback_on = is_enabled;
+    ssd1306_ctx->i2c_err_streak = 0;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_get_stats(
+    ssd1306_stats_t* stats
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(stats == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    *stats = ssd1306_ctx->stats;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_reset_stats()
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    memset(&ssd1306_ctx->stats, 0, sizeof(ssd1306_stats_t));
+
+    return SSD1306_ERR_OK;
+}
+
+uint ssd1306_time_hist_bucket(
+    uint64_t time_us
+)
+{
+    uint bucket = 0;
+
+    for(; time_us > 0 && bucket + 1 < SSD1306_TIME_HIST_BUCKET_COUNT; time_us >>= 1)
+    {
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+uint32_t ssd1306_time_hist_percentile_us(
+    const uint32_t hist[],
+    uint percent
+)
+{
+    uint64_t total = 0;
+
+    for(uint i = 0; i < SSD1306_TIME_HIST_BUCKET_COUNT; ++i)
+    {
+        total += hist[i];
+    }
+
+    if(total == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the percentile sample, 1-based
+    uint64_t rank = (total * (percent > 100 ? 100 : percent) + 99) / 100;
+    uint64_t count = 0;
+
+    rank = rank == 0 ? 1 : rank;
+
+    for(uint i = 0; i + 1 < SSD1306_TIME_HIST_BUCKET_COUNT; ++i)
+    {
+        count += hist[i];
+
+        if(count >= rank)
+        {
+            return 1u << i;
+        }
+    }
+
+    return 1u << (SSD1306_TIME_HIST_BUCKET_COUNT - 2);
+}
+
+uint64_t ssd1306_model_i2c_txn_time_ns(
+    size_t buffer_len,
+    uint freq_khz
+)
+{
+    uint64_t clocks = (uint64_t)(buffer_len + 1) * SSD1306_I2C_CLOCKS_PER_BYTE + SSD1306_I2C_TXN_OVERHEAD_CLOCKS;
+
+    return clocks * 1000000 / freq_khz + SSD1306_I2C_TXN_GAP_NS;
+}
+
+uint64_t ssd1306_model_i2c_time_ns(
+    const ssd1306_stats_t* stats,
+    uint freq_khz
+)
+{
+    // The model is linear, so totals are enough to rescale it to any frequency
+    uint64_t clocks = (uint64_t)(stats->bytes + stats->transactions) * SSD1306_I2C_CLOCKS_PER_BYTE
+        + (uint64_t)stats->transactions * SSD1306_I2C_TXN_OVERHEAD_CLOCKS;
+
+    return clocks * 1000000 / freq_khz + (uint64_t)stats->transactions * SSD1306_I2C_TXN_GAP_NS;
+}
+
+void ssd1306_apply_i2c_clk_freq(
+    uint freq_khz
+)
+{
+    if(ssd1306_ctx->i2c_instance != NULL)
+    {
+        i2c_set_baudrate(ssd1306_ctx->i2c_instance, freq_khz * 1000);
+    }
+
+    ssd1306_ctx->i2c_clk_freq_khz = freq_khz;
+    ssd1306_ctx->i2c_err_streak = 0;
+}
+
+ssd1306_err_t ssd1306_i2c_hw_writev(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count,
+    size_t buffer_len
+)
+{
+    // i2c_write_blocking takes one buffer and a repeated START would begin a new SSD1306 transaction,
+    // so segments are pushed to the TX FIFO directly and STOP is issued after the last byte only
+    i2c_hw_t* hw = i2c_get_hw(ssd1306_ctx->i2c_instance);
+    size_t bytes_left = buffer_len;
+    bool is_abort = false;
+
+    hw->enable = 0;
+    hw->tar = ssd1306_ctx->i2c_address;
+    hw->enable = 1;
+
+    for(size_t i = 0; i < segment_count && !is_abort; ++i)
+    {
+        for(size_t j = 0; j < segments[i].len && !is_abort; ++j)
+        {
+            while(i2c_get_write_available(ssd1306_ctx->i2c_instance) == 0 
+            && !(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))
+            {
+                tight_loop_contents();
+            }
+
+            is_abort = hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+
+            if(!is_abort)
+            {
+                hw->data_cmd = segments[i].data[j] | (--bytes_left == 0 ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+            }
+        }
+    }
+
+    // Aborted transfers are terminated by a STOP as well
+    while(!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS))
+    {
+        tight_loop_contents();
+    }
+
+    is_abort = is_abort || (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS);
+    (void)hw->clr_stop_det;
+
+    if(is_abort)
+    {
+        (void)hw->clr_tx_abrt;
+        return SSD1306_ERR_PICO_ERROR_GENERIC;
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_i2c_writev_once(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    size_t buffer_len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        buffer_len += segments[i].len;
+    }
+
+    uint64_t wire_time_ns = ssd1306_model_i2c_txn_time_ns(buffer_len, ssd1306_ctx->i2c_clk_freq_khz);
+    uint bucket = ssd1306_time_hist_bucket(wire_time_ns / 1000);
+    uint64_t start_us = time_us_64();
+
+    ++ssd1306_ctx->stats.transactions;
+    ssd1306_ctx->stats.bytes += buffer_len;
+    ssd1306_ctx->stats.wire_time_ns += wire_time_ns;
+
+    if(segments[0].data[0] == SSD1306_I2C_HEADER_DATA)
+    {
+        ++ssd1306_ctx->stats.data_transactions;
+        ++ssd1306_ctx->stats.data_wire_time_hist[bucket];
+    }
+    else
+    {
+        ++ssd1306_ctx->stats.cmd_transactions;
+        ++ssd1306_ctx->stats.cmd_wire_time_hist[bucket];
+    }
+
+    ssd1306_err_t error;
+
+    if(ssd1306_ctx->transport_writev != NULL)
+    {
+        error = ssd1306_ctx->transport_writev(ssd1306_ctx->transport_user_data, segments, segment_count);
+    }
+    else
+    if(ssd1306_ctx->transport_write != NULL && segment_count == 1)
+    {
+        error = ssd1306_ctx->transport_write(ssd1306_ctx->transport_user_data, segments[0].data, segments[0].len);
+    }
+    else
+    if(ssd1306_ctx->transport_write != NULL)
+    {
+        // Contiguous transports get segments concatenated
+        error = buffer_len <= ssd1306_ctx->staging_buffer_len ? SSD1306_ERR_OK : SSD1306_ERR_INVALID_BUFF_SIZE;
+
+        for(size_t i = 0, offset = 0; i < segment_count && error == SSD1306_ERR_OK; ++i)
+        {
+            memcpy(ssd1306_ctx->staging_buffer + offset, segments[i].data, segments[i].len);
+            offset += segments[i].len;
+        }
+
+        if(error == SSD1306_ERR_OK)
+        {
+            error = ssd1306_ctx->transport_write(ssd1306_ctx->transport_user_data, ssd1306_ctx->staging_buffer, buffer_len);
+        }
+    }
+    else
+    {
+        error = ssd1306_i2c_hw_writev(segments, segment_count, buffer_len);
+    }
+
+    ssd1306_ctx->stats.bus_time_us += time_us_64() - start_us;
+
+    if(error != SSD1306_ERR_OK)
+    {
+        ++ssd1306_ctx->stats.errors;
+        ++ssd1306_ctx->stats.errors_by_code[error < SSD1306_ERR_COUNT ? error : SSD1306_ERR_PICO_ERROR_GENERIC];
     }
-    
-    ssd1306_err_t error = ssd1306_i2c_write(
-        write_buffer,
-        write_buffer_len
-    );
 
-    free(write_buffer);
     return error;
 }
 
-ssd1306_err_t ssd1306_send_data(
-    uint8_t data[], 
-    size_t data_len
+ssd1306_err_t ssd1306_i2c_writev(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    ssd1306_err_t error = ssd1306_i2c_writev_once(segments, segment_count);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->i2c_err_streak = 0;
+        return error;
+    }
+
+    ++ssd1306_ctx->i2c_err_streak;
+
+    if(ssd1306_ctx->is_clk_fallback_on
+    && ssd1306_ctx->i2c_err_streak >= SSD1306_I2C_FALLBACK_ERR_THRESHOLD
+    && ssd1306_ctx->i2c_clk_freq_khz > SSD1306_I2C_MIN_CLK_FREQ_KHZ)
+    {
+        uint freq_khz = ssd1306_ctx->i2c_clk_freq_khz - SSD1306_I2C_CLK_FREQ_STEP_KHZ;
+
+        if(freq_khz < SSD1306_I2C_MIN_CLK_FREQ_KHZ)
+        {
+            freq_khz = SSD1306_I2C_MIN_CLK_FREQ_KHZ;
+        }
+
+        ssd1306_apply_i2c_clk_freq(freq_khz);
+        error = ssd1306_i2c_writev_once(segments, segment_count);
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_i2c_write(
+    const uint8_t buffer[], 
+    size_t buffer_len
+)
+{
+    const ssd1306_iovec_t segment = { buffer, buffer_len };
+
+    return ssd1306_i2c_writev(&segment, 1);
+}
+
+ssd1306_err_t ssd1306_send_cmd(
+    ssd1306_cmd_t cmd,
+    uint8_t cmd_optios[], 
+    size_t cmd_optios_len
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    const uint8_t header[] = {
+        (uint8_t)SSD1306_I2C_HEADER_CMD,
+        (uint8_t)cmd
+    };
+    const ssd1306_iovec_t segments[] = {
+        { header, count_of(header) },
+        { cmd_optios, cmd_optios_len },
+    };
+
+    return ssd1306_i2c_writev(segments, cmd_optios != NULL && cmd_optios_len > 0 ? 2 : 1);
+}
+
+ssd1306_err_t ssd1306_send_cmd_list(
+    const uint8_t cmds[],
+    size_t cmds_len
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    const uint8_t header = (uint8_t)SSD1306_I2C_HEADER_CMD;
+    const ssd1306_iovec_t segments[] = {
+        { &header, 1 },
+        { cmds, cmds_len },
+    };
+
+    return ssd1306_i2c_writev(segments, count_of(segments));
+}
+
+ssd1306_err_t ssd1306_write_ram(
+    const uint8_t data[], 
+    size_t data_len
+)
+{
+    const ssd1306_iovec_t segment = { data, data_len };
+
+    return ssd1306_write_ram_v(&segment, 1);
+}
+
+ssd1306_err_t ssd1306_write_ram_v(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    const uint8_t header = (uint8_t)SSD1306_I2C_HEADER_DATA;
+    ssd1306_iovec_t write_segments[SSD1306_IOVEC_MAX_COUNT + 1];
+
+    assert(segment_count <= SSD1306_IOVEC_MAX_COUNT);
+
+    write_segments[0].data = &header;
+    write_segments[0].len = 1;
+    memcpy(write_segments + 1, segments, segment_count * sizeof(ssd1306_iovec_t));
+
+    ssd1306_err_t error = ssd1306_i2c_writev(write_segments, segment_count + 1);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->is_ram_valid = true;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_write_ram_prefixed(
+    uint8_t buffer[], 
+    size_t data_len
+)
+{
+    buffer[0] = (uint8_t)SSD1306_I2C_HEADER_DATA;
+
+    ssd1306_err_t error = ssd1306_i2c_write(
+        buffer,
+        data_len + SSD1306_PREFIX_SIZE
+    );
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->is_ram_valid = true;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_send_data(
+    uint8_t data[], 
+    size_t data_len
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(data == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(data_len == 0)
+    {
+        return SSD1306_ERR_ZERO_LEN_DATA;
+    }
+
+    // Target window is unknown here, so none of the page CRCs can be trusted
+    ssd1306_ctx->page_crc_valid_mask = 0;
+
+    return ssd1306_write_ram(data, data_len);
+}
+
+ssd1306_err_t ssd1306_send_data_prefixed(
+    uint8_t buffer[], 
+    size_t data_len
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(data_len == 0)
+    {
+        return SSD1306_ERR_ZERO_LEN_DATA;
+    }
+
+    ssd1306_ctx->page_crc_valid_mask = 0;
+
+    return ssd1306_write_ram_prefixed(buffer, data_len);
+}
+
+ssd1306_err_t ssd1306_send_data_v(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(segments == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(segment_count == 0 || segment_count > SSD1306_IOVEC_MAX_COUNT)
+    {
+        return SSD1306_ERR_INVALID_SEGMENT_COUNT;
+    }
+
+    size_t data_len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        if(segments[i].data == NULL && segments[i].len > 0)
+        {
+            return SSD1306_ERR_NULL_DATA;
+        }
+
+        data_len += segments[i].len;
+    }
+
+    if(data_len == 0)
+    {
+        return SSD1306_ERR_ZERO_LEN_DATA;
+    }
+
+    ssd1306_ctx->page_crc_valid_mask = 0;
+
+    return ssd1306_write_ram_v(segments, segment_count);
+}
+
+ssd1306_err_t ssd1306_send_area_v(
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end,
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(segments == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(segment_count == 0 || segment_count > SSD1306_IOVEC_MAX_COUNT)
+    {
+        return SSD1306_ERR_INVALID_SEGMENT_COUNT;
+    }
+    // Pages outside of the row window are not scanned by the panel
+    uint8_t window_page_end = ssd1306_ctx->window_page_start + ssd1306_ctx->window_page_count;
+
+    if(page_start < ssd1306_ctx->window_page_start || page_start >= window_page_end
+    || page_end < ssd1306_ctx->window_page_start || page_end >= window_page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(page_start > page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE_BOUNDS;
+    }
+    if(col_start >= SSD1306_WIDTH || col_end >= SSD1306_WIDTH)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(col_start > col_end)
+    {
+        return SSD1306_ERR_INVALID_COLUMN_BOUNDS;
+    }
+
+    size_t data_len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        if(segments[i].data == NULL && segments[i].len > 0)
+        {
+            return SSD1306_ERR_NULL_DATA;
+        }
+
+        data_len += segments[i].len;
+    }
+
+    if(data_len == 0)
+    {
+        return SSD1306_ERR_ZERO_LEN_DATA;
+    }
+
+    // Window commands could share the data transaction behind Co control bytes, 
+    // but a control byte per command costs more wire time than a separate transaction
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_COL_ADR, col_start, col_end,
+        SSD1306_CMD_SET_PAGE_ADR, page_start, page_end,
+    };
+
+    for(uint8_t page = page_start; page <= page_end; ++page)
+    {
+        ssd1306_ctx->page_crc_valid_mask &= ~(1 << page);
+    }
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    return ssd1306_write_ram_v(segments, segment_count);
+}
+
+uint32_t ssd1306_crc32(
+    const uint8_t data[], 
+    size_t data_len
+)
+{
+    // CRC-32 (IEEE 802.3) without bit reflection and final XOR, as computed by the RP2040 DMA sniffer
+    uint32_t crc = 0xFFFFFFFF;
+
+#if PICO_ON_DEVICE
+    // Sniffer busy on the other core falls back to the software CRC, which gives the same value
+    if(ssd1306_ctx->crc_dma_channel >= 0 && mutex_try_enter(&ssd1306_crc_sniffer_mutex, NULL))
+    {
+        uint8_t crc_dma_sink;
+        uint channel = (uint)ssd1306_ctx->crc_dma_channel;
+        dma_channel_config config = dma_channel_get_default_config(channel);
+
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_sniff_enable(&config, true);
+
+        dma_sniffer_enable(channel, DMA_SNIFF_CTRL_CALC_VALUE_CRC32, true);
+        dma_hw->sniff_data = crc;
+
+        dma_channel_configure(channel, &config, &crc_dma_sink, data, data_len, true);
+        dma_channel_wait_for_finish_blocking(channel);
+
+        crc = dma_hw->sniff_data;
+        mutex_exit(&ssd1306_crc_sniffer_mutex);
+
+        return crc;
+    }
+#endif
+
+    for(size_t i = 0; i < data_len; ++i)
+    {
+        crc ^= (uint32_t)data[i] << 24;
+
+        for(uint bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+ssd1306_err_t ssd1306_flush(
+    const uint8_t frame[]
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint64_t start_us = time_us_64();
+    ssd1306_err_t error = ssd1306_flush_pages(frame, NULL);
+
+    ssd1306_record_flush(start_us);
+    return error;
+}
+
+ssd1306_err_t ssd1306_flush_prefixed(
+    uint8_t prefixed_frame[]
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(prefixed_frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint64_t start_us = time_us_64();
+    ssd1306_err_t error = ssd1306_flush_pages(prefixed_frame + SSD1306_PREFIX_SIZE, prefixed_frame);
+
+    ssd1306_record_flush(start_us);
+    return error;
+}
+
+void ssd1306_record_flush(
+    uint64_t start_us
+)
+{
+    ++ssd1306_ctx->stats.flushes;
+    ++ssd1306_ctx->stats.flush_latency_hist[ssd1306_time_hist_bucket(time_us_64() - start_us)];
+
+    if(ssd1306_ctx->flush_hook != NULL)
+    {
+        ssd1306_ctx->flush_hook(ssd1306_ctx->flush_hook_user_data);
+    }
+}
+
+ssd1306_err_t ssd1306_flush_pages(
+    const uint8_t frame[],
+    uint8_t prefixed_frame[]
+)
+{
+    uint32_t page_crc[SSD1306_PAGE_COUNT];
+    uint8_t changed_mask = ssd1306_get_changed_pages(frame, page_crc);
+    uint8_t page = ssd1306_ctx->window_page_start;
+    uint8_t window_page_end = ssd1306_ctx->window_page_start + ssd1306_ctx->window_page_count;
+
+    while(page < window_page_end)
+    {
+        if(!(changed_mask & (1 << page)))
+        {
+            ++page;
+            continue;
+        }
+
+        uint8_t page_start = page;
+
+        while(page + 1 < window_page_end && (changed_mask & (1 << (page + 1))))
+        {
+            ++page;
+        }
+
+        ssd1306_err_t error = ssd1306_flush_run(frame, prefixed_frame, page_start, page++, page_crc);
+
+        if(error != SSD1306_ERR_OK)
+        {
+            return error;
+        }
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+uint8_t ssd1306_get_changed_pages(
+    const uint8_t frame[],
+    uint32_t page_crc[]
+)
+{
+    uint8_t changed_mask = 0;
+    uint8_t page_start = ssd1306_ctx->window_page_start;
+
+    // Frame starts at the window, CRCs are kept by RAM page
+    for(uint8_t page = page_start; page < page_start + ssd1306_ctx->window_page_count; ++page)
+    {
+        page_crc[page] = ssd1306_crc32(frame + (page - page_start) * SSD1306_WIDTH, SSD1306_WIDTH);
+
+        if(!(ssd1306_ctx->page_crc_valid_mask & (1 << page)) || page_crc[page] != ssd1306_ctx->page_crc[page])
+        {
+            changed_mask |= 1 << page;
+        }
+    }
+
+    return changed_mask;
+}
+
+ssd1306_err_t ssd1306_flush_run(
+    const uint8_t frame[],
+    uint8_t prefixed_frame[],
+    uint8_t page_start,
+    uint8_t page_end,
+    const uint32_t page_crc[]
+)
+{
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_COL_ADR, 0, SSD1306_WIDTH - 1,
+        SSD1306_CMD_SET_PAGE_ADR, page_start, page_end,
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+
+    if(error == SSD1306_ERR_OK && prefixed_frame != NULL)
+    {
+        // Byte in front of the run is the reserved slot or the last byte of the previous page
+        uint8_t* slot = prefixed_frame + (page_start - ssd1306_ctx->window_page_start) * SSD1306_WIDTH;
+        uint8_t slot_value = *slot;
+
+        error = ssd1306_write_ram_prefixed(
+            slot, 
+            (page_end - page_start + 1) * SSD1306_WIDTH
+        );
+
+        *slot = slot_value;
+    }
+    else
+    if(error == SSD1306_ERR_OK)
+    {
+        error = ssd1306_write_ram(
+            frame + (page_start - ssd1306_ctx->window_page_start) * SSD1306_WIDTH, 
+            (page_end - page_start + 1) * SSD1306_WIDTH
+        );
+    }
+
+    for(uint8_t i = page_start; i <= page_end; ++i)
+    {
+        if(error == SSD1306_ERR_OK)
+        {
+            ssd1306_ctx->page_crc[i] = page_crc[i];
+            ssd1306_ctx->page_crc_valid_mask |= 1 << i;
+        }
+        else
+        {
+            ssd1306_ctx->page_crc_valid_mask &= ~(1 << i);
+        }
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_flush_paced(
+    uint8_t prefixed_frame[]
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(prefixed_frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint64_t start_us = time_us_64();
+    const uint8_t* frame = prefixed_frame + SSD1306_PREFIX_SIZE;
+    uint32_t page_crc[SSD1306_PAGE_COUNT];
+    uint8_t changed_mask = ssd1306_get_changed_pages(frame, page_crc);
+    ssd1306_err_t error = SSD1306_ERR_OK;
+
+    while(changed_mask != 0 && error == SSD1306_ERR_OK)
+    {
+        uint8_t scan_row;
+        ssd1306_get_scan_row(&scan_row);
+
+        // Rows the scan went past since leaving the last row of each page, the least is the page it just left.
+        // Only window pages are ever changed, the lowest one is taken if no lead is found
+        uint8_t window_page_start = ssd1306_ctx->window_page_start;
+        uint8_t window_page_end = window_page_start + ssd1306_ctx->window_page_count;
+        uint8_t window_rows = ssd1306_ctx->window_page_count * SSD1306_PAGE_HEIGHT;
+        uint8_t next_page = window_page_start;
+        uint8_t next_page_lead = window_rows;
+
+        while(!(changed_mask & (1 << next_page)))
+        {
+            ++next_page;
+        }
+
+        for(uint8_t page = window_page_start; page < window_page_end; ++page)
+        {
+            uint8_t lead = (scan_row + window_rows - (page * SSD1306_PAGE_HEIGHT + SSD1306_PAGE_HEIGHT - 1)) % window_rows;
+
+            if((changed_mask & (1 << page)) && lead < next_page_lead)
+            {
+                next_page = page;
+                next_page_lead = lead;
+            }
+        }
+
+        error = ssd1306_flush_run(frame, prefixed_frame, next_page, next_page, page_crc);
+        changed_mask &= ~(1 << next_page);
+    }
+
+    ssd1306_record_flush(start_us);
+    return error;
+}
+
+void ssd1306_update_frame_timing()
+{
+    if(!ssd1306_ctx->is_frame_period_calibrated)
+    {
+        uint32_t osc_freq_level = ssd1306_ctx->dclk_config >> 4;
+        uint32_t dclk_div_ratio = ssd1306_ctx->dclk_config & 0x0F;
+        uint32_t precharge_dclks = (ssd1306_ctx->precharge_config >> 4) + (ssd1306_ctx->precharge_config & 0x0F);
+
+        // Frequency grows with the level, level 0 being about half of the default one
+        uint32_t osc_freq_khz = SSD1306_OSC_FREQ_KHZ * (osc_freq_level + SSD1306_DEFAULT_OSC_FREQ_LEVEL) / (2 * SSD1306_DEFAULT_OSC_FREQ_LEVEL);
+        uint32_t frame_dclks = (dclk_div_ratio + 1) * (precharge_dclks + SSD1306_BANK0_PULSE_DCLKS) * (ssd1306_ctx->mux_ratio + 1);
+
+        ssd1306_ctx->frame_period_us = frame_dclks * 1000 / osc_freq_khz;
+    }
+
+    ssd1306_ctx->frame_epoch_us = time_us_64();
+}
+
+ssd1306_err_t ssd1306_get_frame_period_us(
+    uint32_t* period_us
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(period_us == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    *period_us = ssd1306_ctx->frame_period_us;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_calibrate_frame_period(
+    uint32_t period_us
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    uint64_t epoch_us = ssd1306_ctx->frame_epoch_us;
+
+    ssd1306_ctx->is_frame_period_calibrated = period_us != 0;
+    ssd1306_ctx->frame_period_us = period_us;
+    ssd1306_update_frame_timing();
+
+    // Scan phase is kept
+    ssd1306_ctx->frame_epoch_us = epoch_us;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_get_scan_row(
+    uint8_t* row
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(row == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint32_t period_us = ssd1306_ctx->frame_period_us;
+    uint64_t phase_us = period_us != 0 ? (time_us_64() - ssd1306_ctx->frame_epoch_us) % period_us : 0;
+    uint32_t scan_idx = period_us != 0 ? phase_us * (ssd1306_ctx->mux_ratio + 1) / period_us : 0;
+
+    *row = (ssd1306_ctx->display_start_line + scan_idx) % SSD1306_HEIGHT;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_flush_area(
+    const uint8_t frame[],
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    // Pages outside of the row window are neither in the frame nor scanned by the panel
+    uint8_t window_page_start = ssd1306_ctx->window_page_start;
+    uint8_t window_page_end = window_page_start + ssd1306_ctx->window_page_count;
+
+    if(page_start < window_page_start || page_start >= window_page_end
+    || page_end < window_page_start || page_end >= window_page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(page_start > page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE_BOUNDS;
+    }
+    if(col_start >= SSD1306_WIDTH || col_end >= SSD1306_WIDTH)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(col_start > col_end)
+    {
+        return SSD1306_ERR_INVALID_COLUMN_BOUNDS;
+    }
+
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_COL_ADR, col_start, col_end,
+        SSD1306_CMD_SET_PAGE_ADR, page_start, page_end,
+    };
+
+    uint64_t start_us = time_us_64();
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+    bool is_full_width = col_start == 0 && col_end == SSD1306_WIDTH - 1;
+
+    if(error == SSD1306_ERR_OK && is_full_width)
+    {
+        error = ssd1306_write_ram(
+            frame + (page_start - window_page_start) * SSD1306_WIDTH,
+            (page_end - page_start + 1) * SSD1306_WIDTH
+        );
+    }
+
+    // RAM address pointer wraps inside the window, 
+    // so rows of all pages are gathered into one transaction
+    if(error == SSD1306_ERR_OK && !is_full_width)
+    {
+        ssd1306_iovec_t rows[SSD1306_PAGE_COUNT];
+
+        for(uint8_t page = page_start; page <= page_end; ++page)
+        {
+            rows[page - page_start].data = frame + (page - window_page_start) * SSD1306_WIDTH + col_start;
+            rows[page - page_start].len = col_end - col_start + 1;
+        }
+
+        error = ssd1306_write_ram_v(rows, page_end - page_start + 1);
+    }
+
+    for(uint8_t page = page_start; page <= page_end; ++page)
+    {
+        if(error == SSD1306_ERR_OK && is_full_width)
+        {
+            ssd1306_ctx->page_crc[page] = ssd1306_crc32(frame + (page - window_page_start) * SSD1306_WIDTH, SSD1306_WIDTH);
+            ssd1306_ctx->page_crc_valid_mask |= 1 << page;
+        }
+        else
+        {
+            ssd1306_ctx->page_crc_valid_mask &= ~(1 << page);
+        }
+    }
+
+    ssd1306_record_flush(start_us);
+    return error;
+}
+
+
+ssd1306_err_t ssd1306_build_init_blob(
+    const ssd1306_init_config_t* config,
+    uint8_t blob[]
+)
+{
+    if(config == NULL || blob == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(config->mux_ratio < SSD1306_MIN_MUX_RATIO || config->mux_ratio > SSD1306_MAX_MUX_RATIO)
+    {
+        return SSD1306_ERR_INVALID_MUX_RATIO;
+    }
+    if(config->display_offset >= SSD1306_HEIGHT || config->display_start_line >= SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+    if(config->dclk_div_ratio > SSD1306_MAX_DCLK_DIV_RATIO)
+    {
+        return SSD1306_ERR_INVALID_DCLK_DIV_RATIO;
+    }
+    if(config->osc_freq_level > SSD1306_MAX_OSC_FREQ_LEVEL)
+    {
+        return SSD1306_ERR_INVALID_OSC_FREQ_LEVEL;
+    }
+    if(config->precharge_phase1_period > SSD1306_MAX_PRECHARGE_PHASE_PERIOD 
+    || config->precharge_phase2_period > SSD1306_MAX_PRECHARGE_PHASE_PERIOD)
+    {
+        return SSD1306_ERR_INVALID_PRECHARGE_PHASE_PERIOD;
+    }
+    if (config->vcomh_deselect_level != SSD1306_VCOMH_DESELECT_LVL_0_65
+     && config->vcomh_deselect_level != SSD1306_VCOMH_DESELECT_LVL_0_77
+     && config->vcomh_deselect_level != SSD1306_VCOMH_DESELECT_LVL_0_83
+    )
+    {
+        return SSD1306_ERR_INVALID_VCOMH_DESELECT_LEVEL;
+    }
+
+    ssd1306_com_pin_config_t com_pin_config = config->is_com_pin_config_alt
+        ? (config->is_com_pin_remap_on ? SSD1306_COM_PIN_CONFIG_ALT_REMAP_ON : SSD1306_COM_PIN_CONFIG_ALT_REMAP_OFF)
+        : (config->is_com_pin_remap_on ? SSD1306_COM_PIN_CONFIG_SEQ_REMAP_ON : SSD1306_COM_PIN_CONFIG_SEQ_REMAP_OFF);
+
+    // Same order as the step-by-step power-up sequence, 
+    // all commands share one control byte (Co = 0).
+    // Designators pin the bytes read back by ssd1306_send_init_blob, anything in between keeps its order
+    const uint8_t init_blob[SSD1306_INIT_BLOB_SIZE] = {
+        SSD1306_I2C_HEADER_CMD,
+        SSD1306_CMD_POWER_OFF,
+        SSD1306_CMD_SET_MEM_MODE, SSD1306_MEM_MODE_HORIZONTAL,
+        [SSD1306_INIT_BLOB_START_LINE_IDX] = SSD1306_CMD_SET_DISPLAY_START_LINE | config->display_start_line,
+        [SSD1306_INIT_BLOB_SEG_REMAP_IDX] = config->is_seg_remap_on ? SSD1306_CMD_SEG_REMAP_ON : SSD1306_CMD_SEG_REMAP_OFF,
+        SSD1306_CMD_SET_MUX_RATIO, [SSD1306_INIT_BLOB_MUX_RATIO_IDX] = config->mux_ratio,
+        [SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX] = config->is_com_out_scan_remap_on ? SSD1306_CMD_COM_OUT_REMAP_ON : SSD1306_CMD_COM_OUT_REMAP_OFF,
+        SSD1306_CMD_SET_DISPLAY_OFFSET, config->display_offset,
+        SSD1306_CMD_SET_COM_PIN_CONFIG, com_pin_config,
+        SSD1306_CMD_SET_DCLK_DIV_AND_OSC_FREQ, [SSD1306_INIT_BLOB_DCLK_CONFIG_IDX] = (config->osc_freq_level << 4) | (config->dclk_div_ratio << 0),
+        SSD1306_CMD_SET_PRECHARGE_PERIOD, [SSD1306_INIT_BLOB_PRECHARGE_CONFIG_IDX] = (config->precharge_phase2_period << 4) | (config->precharge_phase1_period << 0),
+        SSD1306_CMD_SET_VCOMH_DESELECT_LVL, config->vcomh_deselect_level,
+        SSD1306_CMD_SET_CONTRAST, [SSD1306_INIT_BLOB_CONTRAST_IDX] = config->contrast,
+        SSD1306_CMD_FOLLOW_RAM,
+        config->is_inversion_on ? SSD1306_CMD_INVERSION_ON : SSD1306_CMD_INVERSION_OFF,
+        SSD1306_CMD_CHARGE_PUMP_MODE, config->is_charge_pump_on ? SSD1306_CHARGE_PUMP_ON : SSD1306_CHARGE_PUMP_OFF,
+        SSD1306_CMD_SCROLLL_OFF,
+        SSD1306_CMD_POWER_ON,
+    };
+
+    memcpy(blob, init_blob, SSD1306_INIT_BLOB_SIZE);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_send_init_blob(
+    const uint8_t blob[]
 )
 {
-    if(!ssd1306_ctx.is_init)
+    if(!ssd1306_ctx->is_init)
     {
         return SSD1306_ERR_DEINITIALIZED;
     }
-    if(data == NULL)
+    if(blob == NULL)
     {
         return SSD1306_ERR_NULL_DATA;
     }
-    if(data_len == SSD1306_ERR_ZERO_LEN_DATA)
+
+    uint8_t mux_ratio = blob[SSD1306_INIT_BLOB_MUX_RATIO_IDX];
+
+    // Settings tracked by the driver are only read from commands known to be at their positions
+    if(blob[0] != SSD1306_I2C_HEADER_CMD
+    || (blob[SSD1306_INIT_BLOB_START_LINE_IDX] & 0xC0) != SSD1306_CMD_SET_DISPLAY_START_LINE
+    || (blob[SSD1306_INIT_BLOB_SEG_REMAP_IDX] != SSD1306_CMD_SEG_REMAP_ON && blob[SSD1306_INIT_BLOB_SEG_REMAP_IDX] != SSD1306_CMD_SEG_REMAP_OFF)
+    || blob[SSD1306_INIT_BLOB_MUX_RATIO_IDX - 1] != SSD1306_CMD_SET_MUX_RATIO
+    || mux_ratio < SSD1306_MIN_MUX_RATIO || mux_ratio > SSD1306_MAX_MUX_RATIO
+    || (blob[SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX] != SSD1306_CMD_COM_OUT_REMAP_ON && blob[SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX] != SSD1306_CMD_COM_OUT_REMAP_OFF)
+    || blob[SSD1306_INIT_BLOB_DCLK_CONFIG_IDX - 1] != SSD1306_CMD_SET_DCLK_DIV_AND_OSC_FREQ
+    || blob[SSD1306_INIT_BLOB_PRECHARGE_CONFIG_IDX - 1] != SSD1306_CMD_SET_PRECHARGE_PERIOD
+    || blob[SSD1306_INIT_BLOB_CONTRAST_IDX - 1] != SSD1306_CMD_SET_CONTRAST)
     {
-        return SSD1306_ERR_NULL_DATA;
+        return SSD1306_ERR_INVALID_INIT_BLOB;
     }
 
-    size_t write_buffer_len = data_len + 1;
-    uint8_t* write_buffer = (uint8_t*)calloc(write_buffer_len, sizeof(uint8_t));
-    
-    write_buffer[0] = (uint8_t)SSD1306_I2C_HEADER_DATA;
-    memcpy(write_buffer + 1, data, data_len);
-    
-    ssd1306_err_t error = ssd1306_i2c_write(
-        write_buffer,
-        write_buffer_len
-    );
+    ssd1306_err_t error = ssd1306_i2c_write(blob, SSD1306_INIT_BLOB_SIZE);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->contrast = blob[SSD1306_INIT_BLOB_CONTRAST_IDX];
+        ssd1306_ctx->is_base_seg_remap_on = blob[SSD1306_INIT_BLOB_SEG_REMAP_IDX] == SSD1306_CMD_SEG_REMAP_ON;
+        ssd1306_ctx->is_base_com_out_scan_remap_on = blob[SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX] == SSD1306_CMD_COM_OUT_REMAP_ON;
+        ssd1306_ctx->orientation = SSD1306_ORIENTATION_0;
+        ssd1306_ctx->window_page_start = 0;
+        ssd1306_ctx->window_page_count = SSD1306_PAGE_COUNT;
+        ssd1306_ctx->display_start_line = blob[SSD1306_INIT_BLOB_START_LINE_IDX] & ~SSD1306_CMD_SET_DISPLAY_START_LINE;
+        ssd1306_ctx->mux_ratio = mux_ratio;
+        ssd1306_ctx->dclk_config = blob[SSD1306_INIT_BLOB_DCLK_CONFIG_IDX];
+        ssd1306_ctx->precharge_config = blob[SSD1306_INIT_BLOB_PRECHARGE_CONFIG_IDX];
+        ssd1306_ctx->power_state = SSD1306_POWER_STATE_ON;
+        ssd1306_update_frame_timing();
+    }
 
-    free(write_buffer);
     return error;
 }
 
+ssd1306_err_t ssd1306_init_display(
+    const ssd1306_init_config_t* config
+)
+{
+    uint8_t blob[SSD1306_INIT_BLOB_SIZE];
+    ssd1306_err_t error = ssd1306_build_init_blob(config, blob);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    return ssd1306_send_init_blob(blob);
+}
+
 
 ssd1306_err_t ssd1306_set_contrast(
     uint8_t contrast
 )
 {
-    return ssd1306_send_cmd(SSD1306_CMD_SET_CONTRAST, NULL, 0);
+    uint8_t cmd_optios[] = {
+        contrast
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_SET_CONTRAST, cmd_optios, count_of(cmd_optios));
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->contrast = contrast;
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_follow_ram()
@@ -308,12 +1654,118 @@ ssd1306_err_t ssd1306_inversion_on()
 
 ssd1306_err_t ssd1306_power_off()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_POWER_OFF, NULL, 0);
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_POWER_OFF, NULL, 0);
+
+    if(error == SSD1306_ERR_OK && ssd1306_ctx->power_state == SSD1306_POWER_STATE_ON)
+    {
+        ssd1306_ctx->power_state = SSD1306_POWER_STATE_OFF;
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_power_on()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_POWER_ON, NULL, 0);
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_POWER_ON, NULL, 0);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->power_state = SSD1306_POWER_STATE_ON;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_sleep()
+{
+    const uint8_t cmds[] = {
+        SSD1306_CMD_POWER_OFF,
+        SSD1306_CMD_CHARGE_PUMP_MODE, SSD1306_CHARGE_PUMP_OFF,
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->power_state = SSD1306_POWER_STATE_SLEEP;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_wake(
+    bool* is_ram_valid
+)
+{
+    const uint8_t cmds[] = {
+        SSD1306_CMD_CHARGE_PUMP_MODE, SSD1306_CHARGE_PUMP_ON,
+        SSD1306_CMD_SET_FADE_OUT_MODE, SSD1306_FADE_OUT_MODE_OFF,
+        SSD1306_CMD_SET_CONTRAST, ssd1306_ctx->contrast,
+        SSD1306_CMD_POWER_ON,
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    ssd1306_ctx->power_state = SSD1306_POWER_STATE_ON;
+
+    if(is_ram_valid != NULL)
+    {
+        *is_ram_valid = ssd1306_ctx->is_ram_valid;
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_set_dim_level(
+    ssd1306_dim_level_t level
+)
+{
+    if(level >= SSD1306_DIM_LEVEL_COUNT)
+    {
+        return SSD1306_ERR_INVALID_DIM_LEVEL;
+    }
+
+    uint8_t cmd_optios[] = {
+        level == SSD1306_DIM_LEVEL_MIN ? 0 : ssd1306_ctx->contrast >> level
+    };
+
+    return ssd1306_send_cmd(SSD1306_CMD_SET_CONTRAST, cmd_optios, count_of(cmd_optios));
+}
+
+ssd1306_err_t ssd1306_get_power_state(
+    ssd1306_power_state_t* power_state
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(power_state == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    *power_state = ssd1306_ctx->power_state;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_invalidate_ram()
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    ssd1306_ctx->is_ram_valid = false;
+    ssd1306_ctx->page_crc_valid_mask = 0;
+
+    return SSD1306_ERR_OK;
 }
 
 
@@ -451,6 +1903,67 @@ ssd1306_err_t ssd1306_vh_scroll_left_setup(
     );
 }
 
+ssd1306_err_t ssd1306_content_scroll_common(
+    ssd1306_cmd_t cmd,
+    uint8_t page_start,
+    uint8_t page_end
+)
+{
+    if(page_start >= SSD1306_PAGE_COUNT || page_end >= SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(page_start > page_end)
+    {
+        return SSD1306_ERR_INVALID_PAGE_BOUNDS;
+    }
+
+    const uint8_t DUMMY_0x00 = 0x00;
+    const uint8_t DUMMY_0x01 = 0x01;
+
+    uint8_t cmd_optios[] = {
+        DUMMY_0x00,
+        page_start,
+        DUMMY_0x01,
+        page_end,
+        0,
+        SSD1306_WIDTH - 1
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd(cmd, cmd_optios, count_of(cmd_optios));
+
+    for(uint8_t page = page_start; page <= page_end; ++page)
+    {
+        ssd1306_ctx->page_crc_valid_mask &= ~(1 << page);
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_content_scroll_right(
+    uint8_t page_start,
+    uint8_t page_end
+)
+{
+    return ssd1306_content_scroll_common(
+        SSD1306_CMD_CONTENT_SCROLL_RIGHT,
+        page_start,
+        page_end
+    );
+}
+
+ssd1306_err_t ssd1306_content_scroll_left(
+    uint8_t page_start,
+    uint8_t page_end
+)
+{
+    return ssd1306_content_scroll_common(
+        SSD1306_CMD_CONTENT_SCROLL_LEFT,
+        page_start,
+        page_end
+    );
+}
+
 ssd1306_err_t ssd1306_scroll_off()
 {
     return ssd1306_send_cmd(SSD1306_CMD_SCROLLL_OFF, NULL, 0);
@@ -458,7 +1971,14 @@ ssd1306_err_t ssd1306_scroll_off()
 
 ssd1306_err_t ssd1306_scroll_on()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_SCROLLL_ON, NULL, 0);
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_SCROLLL_ON, NULL, 0);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->page_crc_valid_mask = 0;
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_set_vscroll_area(
@@ -607,20 +2127,27 @@ ssd1306_err_t ssd1306_set_display_start_line(
         return SSD1306_ERR_INVALID_ROW;
     }
    
-    return ssd1306_send_cmd(
+    ssd1306_err_t error = ssd1306_send_cmd(
         SSD1306_CMD_SET_DISPLAY_START_LINE | row,
         NULL, 0
     );
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->display_start_line = row;
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_seg_remap_off()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_SEG_REMAP_OFF, NULL, 0);
+    return ssd1306_set_base_remap(SSD1306_CMD_SEG_REMAP_OFF);
 }
 
 ssd1306_err_t ssd1306_seg_remap_on()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_SEG_REMAP_ON, NULL, 0);
+    return ssd1306_set_base_remap(SSD1306_CMD_SEG_REMAP_ON);
 }
 
 ssd1306_err_t ssd1306_set_mux_ratio(
@@ -636,17 +2163,201 @@ ssd1306_err_t ssd1306_set_mux_ratio(
         mux_ratio
     };
 
-    return ssd1306_send_cmd(SSD1306_CMD_SET_MUX_RATIO, cmd_optios, count_of(cmd_optios));
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_SET_MUX_RATIO, cmd_optios, count_of(cmd_optios));
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->mux_ratio = mux_ratio;
+        ssd1306_update_frame_timing();
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_com_out_scan_remap_off()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_COM_OUT_REMAP_OFF, NULL, 0);
+    return ssd1306_set_base_remap(SSD1306_CMD_COM_OUT_REMAP_OFF);
 }
 
 ssd1306_err_t ssd1306_com_out_scan_remap_on()
 {
-    return ssd1306_send_cmd(SSD1306_CMD_COM_OUT_REMAP_ON, NULL, 0);
+    return ssd1306_set_base_remap(SSD1306_CMD_COM_OUT_REMAP_ON);
+}
+
+ssd1306_err_t ssd1306_set_base_remap(
+    ssd1306_cmd_t cmd
+)
+{
+    ssd1306_err_t error = ssd1306_send_cmd(cmd, NULL, 0);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    bool is_com_cmd = cmd == SSD1306_CMD_COM_OUT_REMAP_ON || cmd == SSD1306_CMD_COM_OUT_REMAP_OFF;
+
+    // Remaps sent directly become the mounting orientations are computed against
+    if(is_com_cmd)
+    {
+        ssd1306_ctx->is_base_com_out_scan_remap_on = cmd == SSD1306_CMD_COM_OUT_REMAP_ON;
+    }
+    else
+    {
+        ssd1306_ctx->is_base_seg_remap_on = cmd == SSD1306_CMD_SEG_REMAP_ON;
+    }
+
+    ssd1306_ctx->orientation = SSD1306_ORIENTATION_0;
+    ssd1306_ctx->is_ram_valid = false;
+    ssd1306_ctx->page_crc_valid_mask = 0;
+
+    // Window offset depends on the COM scan direction
+    if(is_com_cmd && ssd1306_ctx->window_page_count != SSD1306_PAGE_COUNT)
+    {
+        uint8_t cmd_optios[] = {
+            ssd1306_get_window_offset(SSD1306_ORIENTATION_0)
+        };
+
+        error = ssd1306_send_cmd(SSD1306_CMD_SET_DISPLAY_OFFSET, cmd_optios, count_of(cmd_optios));
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_set_orientation(
+    ssd1306_orientation_t orientation
+)
+{
+    if(orientation >= SSD1306_ORIENTATION_COUNT)
+    {
+        return SSD1306_ERR_INVALID_ORIENTATION;
+    }
+
+    bool is_seg_flipped = orientation == SSD1306_ORIENTATION_90
+        || orientation == SSD1306_ORIENTATION_180
+        || orientation == SSD1306_ORIENTATION_MIRROR_X;
+    bool is_com_flipped = orientation == SSD1306_ORIENTATION_180
+        || orientation == SSD1306_ORIENTATION_270
+        || orientation == SSD1306_ORIENTATION_MIRROR_Y;
+
+    // Window offset depends on the COM scan direction
+    const uint8_t cmds[] = {
+        ssd1306_ctx->is_base_seg_remap_on != is_seg_flipped ? SSD1306_CMD_SEG_REMAP_ON : SSD1306_CMD_SEG_REMAP_OFF,
+        ssd1306_ctx->is_base_com_out_scan_remap_on != is_com_flipped ? SSD1306_CMD_COM_OUT_REMAP_ON : SSD1306_CMD_COM_OUT_REMAP_OFF,
+        SSD1306_CMD_SET_DISPLAY_OFFSET, ssd1306_get_window_offset(orientation),
+    };
+    bool is_window_set = ssd1306_ctx->window_page_count != SSD1306_PAGE_COUNT;
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, is_window_set ? count_of(cmds) : 2);
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->orientation = orientation;
+        ssd1306_ctx->is_ram_valid = false;
+        ssd1306_ctx->page_crc_valid_mask = 0;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_get_orientation(
+    ssd1306_orientation_t* orientation
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(orientation == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    *orientation = ssd1306_ctx->orientation;
+
+    return SSD1306_ERR_OK;
+}
+
+uint8_t ssd1306_get_window_offset(
+    ssd1306_orientation_t orientation
+)
+{
+    bool is_com_flipped = orientation == SSD1306_ORIENTATION_180
+        || orientation == SSD1306_ORIENTATION_270
+        || orientation == SSD1306_ORIENTATION_MIRROR_Y;
+    uint8_t row_start = ssd1306_ctx->window_page_start * SSD1306_PAGE_HEIGHT;
+    uint8_t row_count = ssd1306_ctx->window_page_count * SSD1306_PAGE_HEIGHT;
+
+    // Scan of N rows drives COM0..COM(N-1), or COM(N-1)..COM0 when remapped, shifted by the offset.
+    // Window row 0 goes on the COM showing RAM row row_start with the full multiplex ratio.
+    if(ssd1306_ctx->is_base_com_out_scan_remap_on != is_com_flipped)
+    {
+        return (row_start + row_count) % SSD1306_HEIGHT;
+    }
+
+    return (SSD1306_HEIGHT - row_start) % SSD1306_HEIGHT;
+}
+
+ssd1306_err_t ssd1306_set_row_window(
+    uint8_t page_start,
+    uint8_t page_count
+)
+{
+    if(page_start >= SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE;
+    }
+    if(page_count < SSD1306_MIN_WINDOW_PAGE_COUNT || page_start + page_count > SSD1306_PAGE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_PAGE_BOUNDS;
+    }
+
+    uint8_t prev_page_start = ssd1306_ctx->window_page_start;
+    uint8_t prev_page_count = ssd1306_ctx->window_page_count;
+
+    ssd1306_ctx->window_page_start = page_start;
+    ssd1306_ctx->window_page_count = page_count;
+
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_MUX_RATIO, page_count * SSD1306_PAGE_HEIGHT - 1,
+        SSD1306_CMD_SET_DISPLAY_OFFSET, ssd1306_get_window_offset(ssd1306_ctx->orientation),
+        SSD1306_CMD_SET_DISPLAY_START_LINE | (page_start * SSD1306_PAGE_HEIGHT),
+    };
+
+    ssd1306_err_t error = ssd1306_send_cmd_list(cmds, count_of(cmds));
+
+    if(error != SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->window_page_start = prev_page_start;
+        ssd1306_ctx->window_page_count = prev_page_count;
+        return error;
+    }
+
+    ssd1306_ctx->mux_ratio = page_count * SSD1306_PAGE_HEIGHT - 1;
+    ssd1306_ctx->display_start_line = page_start * SSD1306_PAGE_HEIGHT;
+    ssd1306_update_frame_timing();
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_get_row_window(
+    uint8_t* page_start,
+    uint8_t* page_count
+)
+{
+    if(!ssd1306_ctx->is_init)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+    if(page_start == NULL || page_count == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    *page_start = ssd1306_ctx->window_page_start;
+    *page_count = ssd1306_ctx->window_page_count;
+
+    return SSD1306_ERR_OK;
 }
 
 ssd1306_err_t ssd1306_set_display_offset(
@@ -717,7 +2428,15 @@ ssd1306_err_t ssd1306_set_dclk_div_and_osc_freq(
         (osc_freq_level << 4) | (dclk_div_ratio << 0)
     };
 
-    return ssd1306_send_cmd(SSD1306_CMD_SET_DCLK_DIV_AND_OSC_FREQ, cmd_optios, count_of(cmd_optios));
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_SET_DCLK_DIV_AND_OSC_FREQ, cmd_optios, count_of(cmd_optios));
+
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->dclk_config = cmd_optios[0];
+        ssd1306_update_frame_timing();
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_set_precharge_period(
@@ -734,8 +2453,15 @@ ssd1306_err_t ssd1306_set_precharge_period(
         (phase2_peroid << 4) | (phase1_peroid << 0)
     };
 
-    return ssd1306_send_cmd(SSD1306_CMD_SET_PRECHARGE_PERIOD, cmd_optios, count_of(cmd_optios));
+    ssd1306_err_t error = ssd1306_send_cmd(SSD1306_CMD_SET_PRECHARGE_PERIOD, cmd_optios, count_of(cmd_optios));
 
+    if(error == SSD1306_ERR_OK)
+    {
+        ssd1306_ctx->precharge_config = cmd_optios[0];
+        ssd1306_update_frame_timing();
+    }
+
+    return error;
 }
 
 ssd1306_err_t ssd1306_set_vcomh_deselect_level(
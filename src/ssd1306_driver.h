@@ -11,24 +11,50 @@
 #include <stdint.h>
 #include <hardware/i2c.h>
 
+#include "ssd1306_spec.h"
+
 /**
- * @def SSD1306_HEIGHT
- * @brief Height of the SSD1306 display in pixels.
+ * @def SSD1306_PREFIX_SIZE
+ * @brief Size of the slot reserved in front of prefixed buffers for the I2C control byte.
+ *
+ * @def SSD1306_PREFIXED_FRAME_SIZE
+ * @brief Size of a prefixed frame buffer: reserved slot followed by SSD1306_RAM_BUFF_SIZE bytes of RAM data.
  *
- * @def SSD1306_WIDTH
- * @brief Width of the SSD1306 display in pixels.
+ * @def SSD1306_STAGING_BUFF_SIZE
+ * @brief Size of the buffer segments are concatenated in for contiguous transports, the largest transaction sent by a flush.
  *
- * @def SSD1306_PAGE_HEIGHT
- * @brief Height of each page in the SSD1306 display in pixels.
+ * @def SSD1306_MIN_WINDOW_PAGE_COUNT
+ * @brief Minimum number of pages of a row window, the lowest multiplex ratio covers 16 rows.
  *
- * @def SSD1306_PAGE_COUNT
- * @brief Number of pages in the SSD1306 display.
+ * @def SSD1306_WINDOW_FRAME_SIZE
+ * @brief Size in bytes of the frame of a row window page_count pages high.
  *
- * @def SSD1306_RAM_BUFF_SIZE
- * @brief Size of the RAM buffer for the SSD1306 display in bytes.
+ * @def SSD1306_WINDOW_PREFIXED_FRAME_SIZE
+ * @brief Size in bytes of the prefixed frame of a row window page_count pages high.
  * 
  * @def SSD1306_I2C_CLK_FREQ_KHZ
- * @brief I2C clock frequency for communication with the SSD1306 display in kilohertz.
+ * @brief Default I2C clock frequency for communication with the SSD1306 display in kilohertz.
+ *
+ * @def SSD1306_I2C_MIN_CLK_FREQ_KHZ
+ * @brief Minimum I2C clock frequency (Standard-mode) in kilohertz.
+ *
+ * @def SSD1306_I2C_MAX_CLK_FREQ_KHZ
+ * @brief Maximum I2C clock frequency (Fast-mode Plus) in kilohertz.
+ *
+ * @def SSD1306_I2C_CLK_FREQ_STEP_KHZ
+ * @brief I2C clock frequency step used by calibration and automatic fallback in kilohertz.
+ *
+ * @def SSD1306_I2C_CALIB_PROBE_COUNT
+ * @brief Number of test pattern writes performed on each calibration step.
+ *
+ * @def SSD1306_I2C_FALLBACK_ERR_THRESHOLD
+ * @brief Number of consecutive I2C errors that triggers a clock frequency step down.
+ *
+ * @def SSD1306_IOVEC_MAX_COUNT
+ * @brief Maximum number of segments gathered into one RAM data transaction.
+ *
+ * @def SSD1306_TIME_HIST_BUCKET_COUNT
+ * @brief Number of buckets of timing histograms. Bucket 0 counts times below 1 us, bucket N times in [2^(N-1), 2^N) us.
  * 
  * @def SSD1306_I2C_ADDRESS
  * @brief I2C address of the SSD1306 display.
@@ -56,13 +82,51 @@
  *
  * @def SSD1306_DEFAULT_PRECHARGE_PHASE_PERIOD
  * @brief Default precharge phase period for the SSD1306 display.
+ *
+ * @def SSD1306_INIT_BLOB_SIZE
+ * @brief Size of the initialization command blob in bytes, I2C control byte included.
+ *
+ * @def SSD1306_INIT_BLOB_START_LINE_IDX
+ * @brief Position of the display start line command in the initialization command blob.
+ *
+ * @def SSD1306_INIT_BLOB_SEG_REMAP_IDX
+ * @brief Position of the SEG remap command in the initialization command blob.
+ *
+ * @def SSD1306_INIT_BLOB_MUX_RATIO_IDX
+ * @brief Position of the multiplex ratio in the initialization command blob, following its command.
+ *
+ * @def SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX
+ * @brief Position of the COM scan direction command in the initialization command blob.
+ *
+ * @def SSD1306_INIT_BLOB_DCLK_CONFIG_IDX
+ * @brief Position of the display clock setting in the initialization command blob, following its command.
+ *
+ * @def SSD1306_INIT_BLOB_PRECHARGE_CONFIG_IDX
+ * @brief Position of the precharge period setting in the initialization command blob, following its command.
+ *
+ * @def SSD1306_INIT_BLOB_CONTRAST_IDX
+ * @brief Position of the contrast level in the initialization command blob, following its command.
+ *
+ * @def SSD1306_OSC_FREQ_KHZ
+ * @brief Typical oscillator frequency at SSD1306_DEFAULT_OSC_FREQ_LEVEL in kilohertz.
+ *
+ * @def SSD1306_BANK0_PULSE_DCLKS
+ * @brief Length of the segment current drive phase of every row in DCLKs.
  */
-#define SSD1306_HEIGHT                          _u(64)
-#define SSD1306_WIDTH                           _u(128)
-#define SSD1306_PAGE_HEIGHT                     _u(8)
-#define SSD1306_PAGE_COUNT                      (SSD1306_HEIGHT / SSD1306_PAGE_HEIGHT)
-#define SSD1306_RAM_BUFF_SIZE                   (SSD1306_PAGE_COUNT * SSD1306_WIDTH) 
+#define SSD1306_PREFIX_SIZE                     _u(1)
+#define SSD1306_PREFIXED_FRAME_SIZE             (SSD1306_PREFIX_SIZE + SSD1306_RAM_BUFF_SIZE)
+#define SSD1306_STAGING_BUFF_SIZE               SSD1306_PREFIXED_FRAME_SIZE
+#define SSD1306_MIN_WINDOW_PAGE_COUNT           _u(2)
+#define SSD1306_WINDOW_FRAME_SIZE(page_count)   ((page_count) * SSD1306_WIDTH)
+#define SSD1306_WINDOW_PREFIXED_FRAME_SIZE(page_count) (SSD1306_PREFIX_SIZE + SSD1306_WINDOW_FRAME_SIZE(page_count))
 #define SSD1306_I2C_CLK_FREQ_KHZ                _u(400)
+#define SSD1306_I2C_MIN_CLK_FREQ_KHZ            _u(100)
+#define SSD1306_I2C_MAX_CLK_FREQ_KHZ            _u(1000)
+#define SSD1306_I2C_CLK_FREQ_STEP_KHZ           _u(100)
+#define SSD1306_I2C_CALIB_PROBE_COUNT           _u(16)
+#define SSD1306_I2C_FALLBACK_ERR_THRESHOLD      _u(3)
+#define SSD1306_IOVEC_MAX_COUNT                 _u(16)
+#define SSD1306_TIME_HIST_BUCKET_COUNT          _u(16)
 #define SSD1306_I2C_ADDRESS                     _u(0x3C)
 #define SSD1306_MIN_MUX_RATIO                   _u(0x0F)
 #define SSD1306_MAX_MUX_RATIO                   _u(0x3F)
@@ -72,6 +136,16 @@
 #define SSD1306_DEFAULT_DCLK_DIV_RATIO          _u(0)
 #define SSD1306_DEFAULT_OSC_FREQ_LEVEL          _u(8)
 #define SSD1306_DEFAULT_PRECHARGE_PHASE_PERIOD  _u(2)
+#define SSD1306_INIT_BLOB_SIZE                  _u(27)
+#define SSD1306_INIT_BLOB_START_LINE_IDX        _u(4)
+#define SSD1306_INIT_BLOB_SEG_REMAP_IDX         _u(5)
+#define SSD1306_INIT_BLOB_MUX_RATIO_IDX         _u(7)
+#define SSD1306_INIT_BLOB_COM_OUT_SCAN_REMAP_IDX _u(8)
+#define SSD1306_INIT_BLOB_DCLK_CONFIG_IDX       _u(14)
+#define SSD1306_INIT_BLOB_PRECHARGE_CONFIG_IDX  _u(16)
+#define SSD1306_INIT_BLOB_CONTRAST_IDX          _u(20)
+#define SSD1306_OSC_FREQ_KHZ                    _u(370)
+#define SSD1306_BANK0_PULSE_DCLKS               _u(50)
 
 
 /**
@@ -107,6 +181,28 @@ typedef enum ssd1306_err_t
     SSD1306_ERR_INVALID_VCOMH_DESELECT_LEVEL,     /**< Invalid VCOMH deselect level. */
     SSD1306_ERR_INVALID_FADEOUT_MODE,             /**< Invalid fadeout mode. */
     SSD1306_ERR_INVALID_FADEOUT_FREQ,             /**< Invalid fadeout frequency. */
+    SSD1306_ERR_INVALID_I2C_CLK_FREQ,             /**< Invalid I2C clock frequency. [100, 1000] kHz required */
+    SSD1306_ERR_I2C_CALIBRATION_FAILED,           /**< No I2C clock frequency passed the calibration test pattern. */
+    SSD1306_ERR_INVALID_DIM_LEVEL,                /**< Invalid dimming level. */
+    SSD1306_ERR_INVALID_CANVAS_SIZE,              /**< Canvas size doesn't match the required one. */
+    SSD1306_ERR_WIDGET_POOL_FULL,                 /**< No free widget slots left in the pool. */
+    SSD1306_ERR_INVALID_WIDGET,                   /**< Widget identifier doesn't refer to a live widget. */
+    SSD1306_ERR_INVALID_WIDGET_TYPE,              /**< Invalid widget type. */
+    SSD1306_ERR_INVALID_SEGMENT_COUNT,            /**< Invalid number of segments. [1, SSD1306_IOVEC_MAX_COUNT] required */
+    SSD1306_ERR_INVALID_ASSET_PACK,               /**< Asset pack header or index is malformed. */
+    SSD1306_ERR_INVALID_ASSET_IDX,                /**< Asset index is out of the pack. */
+    SSD1306_ERR_INVALID_BUFF_SIZE,                /**< Provided buffer is too small. */
+    SSD1306_ERR_INVALID_NET_PACKET,               /**< Network packet is malformed. */
+    SSD1306_ERR_NET_ERROR,                        /**< Network stack error. */
+    SSD1306_ERR_INVALID_DITHER_MODE,              /**< Invalid dithering mode. */
+    SSD1306_ERR_INVALID_ORIENTATION,              /**< Invalid display orientation. */
+    SSD1306_ERR_INVALID_PANEL,                    /**< Panel outside of the wall or on an invalid bus. */
+    SSD1306_ERR_ARENA_FULL,                       /**< Not enough free memory left in the arena. */
+    SSD1306_ERR_INVALID_CLIP_DEPTH,               /**< Clip stack is full on push or empty on pop. */
+    SSD1306_ERR_INVALID_CHART_SHIFT,              /**< Invalid chart shift mode. */
+    SSD1306_ERR_INVALID_CHART_RANGE,              /**< Chart value range is empty. */
+    SSD1306_ERR_INVALID_INIT_BLOB,                /**< Initialization command blob doesn't have the layout built by ssd1306_build_init_blob. */
+    SSD1306_ERR_COUNT,                            /**< Total number of valid values. */
 } ssd1306_err_t;
 
 
@@ -177,6 +273,212 @@ typedef enum ssd1306_fade_out_freq_t
     SSD1306_FADE_OUT_FREQ_COUNT = _u(16),     /**< Total number of valid values. */
 } ssd1306_fade_out_freq_t;
 
+/**
+ * @brief Transport write function used instead of the I2C peripheral.
+ * Receives whole I2C transactions without the address byte: control byte followed by commands or RAM data.
+ *
+ * @param user_data User data pointer passed to ssd1306_init_transport.
+ * @param buffer Transaction bytes.
+ * @param buffer_len Number of transaction bytes.
+ * @return API error code.
+ */
+typedef ssd1306_err_t (*ssd1306_transport_write_t)(
+    void* user_data,
+    const uint8_t buffer[],
+    size_t buffer_len
+);
+
+/**
+ * @struct ssd1306_iovec_t
+ * @brief Segment of a gather write, e.g. a control byte, a frame row or a flash-resident bitmap.
+ */
+typedef struct ssd1306_iovec_t
+{
+    const uint8_t* data;    /**< Segment bytes. */
+    size_t len;             /**< Number of segment bytes. */
+}
+ssd1306_iovec_t;
+
+/**
+ * @brief Gather transport write function used instead of the I2C peripheral.
+ * Segments are parts of a single I2C transaction and go out back to back in the given order.
+ *
+ * @param user_data User data pointer passed to ssd1306_init_transport_v.
+ * @param segments Transaction segments.
+ * @param segment_count Number of segments.
+ * @return API error code.
+ */
+typedef ssd1306_err_t (*ssd1306_transport_writev_t)(
+    void* user_data,
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+
+/**
+ * @brief Function called at the end of every flush, after its last transaction.
+ *
+ * @param user_data User data pointer passed to ssd1306_set_flush_hook.
+ */
+typedef void (*ssd1306_flush_hook_t)(
+    void* user_data
+);
+
+/**
+ * @struct ssd1306_stats_t
+ * @brief Bus traffic counters.
+ * Wire time is modeled at the I2C clock frequency in use when each transaction was sent,
+ * see ssd1306_model_i2c_txn_time_ns.
+ */
+typedef struct ssd1306_stats_t
+{
+    uint32_t transactions;                                      /**< Number of transactions. */
+    uint32_t cmd_transactions;                                  /**< Number of command transactions. */
+    uint32_t data_transactions;                                 /**< Number of RAM data transactions. */
+    uint32_t bytes;                                             /**< Number of bytes following the address byte, control bytes included. */
+    uint32_t errors;                                            /**< Number of failed transactions. */
+    uint32_t errors_by_code[SSD1306_ERR_COUNT];                 /**< Number of failed transactions by returned error code. */
+    uint64_t wire_time_ns;                                      /**< Modeled wire time of all transactions. */
+    uint64_t bus_time_us;                                       /**< Measured time spent writing transactions. */
+    uint32_t cmd_wire_time_hist[SSD1306_TIME_HIST_BUCKET_COUNT];    /**< Histogram of modeled command transaction times. */
+    uint32_t data_wire_time_hist[SSD1306_TIME_HIST_BUCKET_COUNT];   /**< Histogram of modeled RAM data transaction times. */
+    uint32_t flushes;                                           /**< Number of ssd1306_flush, ssd1306_flush_prefixed and ssd1306_flush_area calls. */
+    uint32_t flush_latency_hist[SSD1306_TIME_HIST_BUCKET_COUNT];    /**< Histogram of measured flush call durations. */
+}
+ssd1306_stats_t;
+
+/**
+ * @enum ssd1306_power_state_t
+ * @brief Enumeration of power states tracked by the power manager.
+ */
+typedef enum ssd1306_power_state_t
+{
+    SSD1306_POWER_STATE_ON,     /**< Display is on. */
+    SSD1306_POWER_STATE_OFF,    /**< Display is off, charge pump keeps running. */
+    SSD1306_POWER_STATE_SLEEP,  /**< Display and charge pump are off. RAM content is retained. */
+} ssd1306_power_state_t;
+
+/**
+ * @enum ssd1306_dim_level_t
+ * @brief Enumeration of dimming stages. Each stage scales down the contrast set by ssd1306_set_contrast.
+ */
+typedef enum ssd1306_dim_level_t
+{
+    SSD1306_DIM_LEVEL_FULL,     /**< Full contrast. */
+    SSD1306_DIM_LEVEL_HALF,     /**< Half of full contrast. */
+    SSD1306_DIM_LEVEL_QUARTER,  /**< Quarter of full contrast. */
+    SSD1306_DIM_LEVEL_MIN,      /**< Minimal contrast. Pixels are still visible. */
+    SSD1306_DIM_LEVEL_COUNT,    /**< Total number of valid values. */
+} ssd1306_dim_level_t;
+
+/**
+ * @enum ssd1306_orientation_t
+ * @brief Enumeration of display orientations, clockwise and relative to the remaps set by ssd1306_init_display.
+ * Rotations by 90 and 270 degrees expect a portrait frame transposed by ssd1306_gfx_transpose_area.
+ */
+typedef enum ssd1306_orientation_t
+{
+    SSD1306_ORIENTATION_0,          /**< As mounted. */
+    SSD1306_ORIENTATION_90,         /**< Rotated by 90 degrees, SEG remap flipped over a transposed frame. */
+    SSD1306_ORIENTATION_180,        /**< Rotated by 180 degrees, both SEG remap and COM scan flipped. */
+    SSD1306_ORIENTATION_270,        /**< Rotated by 270 degrees, COM scan flipped over a transposed frame. */
+    SSD1306_ORIENTATION_MIRROR_X,   /**< Mirrored left to right, SEG remap flipped. */
+    SSD1306_ORIENTATION_MIRROR_Y,   /**< Mirrored top to bottom, COM scan flipped. */
+    SSD1306_ORIENTATION_COUNT,      /**< Total number of valid values. */
+} ssd1306_orientation_t;
+
+/**
+ * @struct ssd1306_instance_t
+ * @brief State of one display, fields are private to the driver.
+ * Zero initialize before its first ssd1306_init_* call, see ssd1306_select_instance.
+ */
+typedef struct ssd1306_instance_t
+{
+    i2c_inst_t* i2c_instance;                       /**< I2C instance, NULL with a custom transport. */
+    uint8_t i2c_address;                            /**< I2C address of the display. */
+    uint sda_pin;                                   /**< SDA pin. */
+    uint scl_pin;                                   /**< SCL pin. */
+    ssd1306_transport_write_t transport_write;      /**< Custom transport write function. */
+    ssd1306_transport_writev_t transport_writev;    /**< Custom segmented transport write function. */
+    void* transport_user_data;                      /**< User data pointer passed to the custom transport. */
+    uint8_t* staging_buffer;                        /**< Buffer segments are concatenated in for a contiguous transport. */
+    size_t staging_buffer_len;                      /**< Size of the staging buffer. */
+    ssd1306_stats_t stats;                          /**< Bus traffic counters. */
+    ssd1306_flush_hook_t flush_hook;                /**< Function called at the end of every flush or NULL. */
+    void* flush_hook_user_data;                     /**< User data pointer passed to the flush hook. */
+    uint i2c_clk_freq_khz;                          /**< I2C clock frequency in kilohertz. */
+    uint i2c_err_streak;                            /**< Number of consecutive failed transactions. */
+    bool is_clk_fallback_on;                        /**< Whether the I2C clock falls back to a lower frequency on errors. */
+    ssd1306_power_state_t power_state;              /**< Display power state. */
+    uint8_t contrast;                               /**< Contrast level set by the application. */
+    uint8_t mux_ratio;                              /**< Multiplex ratio minus one. */
+    uint8_t display_start_line;                     /**< Display start line. */
+    uint8_t dclk_config;                            /**< Display clock divide ratio and oscillator frequency setting. */
+    uint8_t precharge_config;                       /**< Precharge period setting. */
+    uint32_t frame_period_us;                       /**< Estimated or calibrated display frame period. */
+    bool is_frame_period_calibrated;                /**< Whether the frame period was set by ssd1306_calibrate_frame_period. */
+    uint64_t frame_epoch_us;                        /**< Time a frame scan is estimated to have started at. */
+    bool is_base_seg_remap_on;                      /**< SEG remap sent by ssd1306_init_display. */
+    bool is_base_com_out_scan_remap_on;             /**< COM scan direction remap sent by ssd1306_init_display. */
+    ssd1306_orientation_t orientation;              /**< Display orientation. */
+    uint8_t window_page_start;                      /**< First RAM page of the row window. */
+    uint8_t window_page_count;                      /**< Number of pages of the row window. */
+    bool is_ram_valid;                              /**< Whether display RAM holds the last sent content. */
+    uint32_t page_crc[SSD1306_PAGE_COUNT];          /**< CRC of every page last sent by a flush. */
+    uint8_t page_crc_valid_mask;                    /**< Pages with a valid CRC. */
+    int crc_dma_channel;                            /**< DMA channel of the CRC sniffer, -1 for software CRCs. */
+    bool is_init;                                   /**< Whether the instance is initialized. */
+}
+ssd1306_instance_t;
+
+
+/**
+ * @struct ssd1306_init_config_t
+ * @brief Declarative power-up configuration of the SSD1306 display.
+ * Turned into a single command blob by ssd1306_build_init_blob.
+ * Horizontal memory addressing mode, RAM following and disabled scrolling are always set.
+ */
+typedef struct ssd1306_init_config_t
+{
+    uint8_t mux_ratio;                          /**< Multiplex ratio minus one. [15, 63] required */
+    uint8_t display_offset;                     /**< Vertical shift by COM. [0, 63] required */
+    uint8_t display_start_line;                 /**< Display start line. [0, 63] required */
+    bool is_seg_remap_on;                       /**< SEG hardware column address remap. */
+    bool is_com_out_scan_remap_on;              /**< COM output scan direction remap. */
+    bool is_com_pin_config_alt;                 /**< Alternative COM pin configuration, sequential otherwise. */
+    bool is_com_pin_remap_on;                   /**< COM left/right remap. */
+    uint8_t dclk_div_ratio;                     /**< Display clock divider ratio minus one. [0, 15] required */
+    uint8_t osc_freq_level;                     /**< Oscillator frequency level. [0, 15] required */
+    uint8_t precharge_phase1_period;            /**< Phase 1 precharge period in DCLK. [0, 15] required */
+    uint8_t precharge_phase2_period;            /**< Phase 2 precharge period in DCLK. [0, 15] required */
+    ssd1306_vcomh_t vcomh_deselect_level;       /**< VCOMH deselect level. */
+    uint8_t contrast;                           /**< Contrast level. */
+    bool is_inversion_on;                       /**< Pixel value inversion. */
+    bool is_charge_pump_on;                     /**< Internal charge pump. */
+} 
+ssd1306_init_config_t;
+
+/**
+ * @def SSD1306_INIT_CONFIG_DEFAULT
+ * @brief Initializer of ssd1306_init_config_t for a 128x64 module powered by its internal charge pump.
+ */
+#define SSD1306_INIT_CONFIG_DEFAULT {                               \
+    .mux_ratio                  = SSD1306_HEIGHT - 1,               \
+    .display_offset             = 0,                                \
+    .display_start_line         = 0,                                \
+    .is_seg_remap_on            = true,                             \
+    .is_com_out_scan_remap_on   = true,                             \
+    .is_com_pin_config_alt      = true,                             \
+    .is_com_pin_remap_on        = false,                            \
+    .dclk_div_ratio             = SSD1306_DEFAULT_DCLK_DIV_RATIO,   \
+    .osc_freq_level             = SSD1306_DEFAULT_OSC_FREQ_LEVEL,   \
+    .precharge_phase1_period    = 1,                                \
+    .precharge_phase2_period    = 15,                               \
+    .vcomh_deselect_level       = SSD1306_VCOMH_DESELECT_LVL_0_83,  \
+    .contrast                   = 0xFF,                             \
+    .is_inversion_on            = false,                            \
+    .is_charge_pump_on          = true,                             \
+}
+
 
 /**
  * @brief Initializes the SSD1306 display using the specified I2C instance and pin configuration.
@@ -199,8 +501,209 @@ ssd1306_err_t ssd1306_init_i2c(
  */
 ssd1306_err_t ssd1306_deinit_i2c();
 
+/**
+ * @brief Initializes the driver on top of a custom transport instead of the I2C peripheral,
+ * e.g. a simulated one used for benchmarking. Deinitialized by ssd1306_deinit_i2c.
+ * Transactions gathered from several segments, e.g. RAM data behind its control byte, are concatenated
+ * in the staging buffer, which stays in use until deinitialization.
+ *
+ * @param write Transport write function.
+ * @param user_data User data pointer passed to every write.
+ * @param staging_buffer Buffer segments are concatenated in, e.g. taken by ssd1306_arena_alloc_staging_buffer.
+ * @param staging_buffer_len Size of the staging buffer, at least SSD1306_STAGING_BUFF_SIZE.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_init_transport(
+    ssd1306_transport_write_t write,
+    void* user_data,
+    uint8_t staging_buffer[],
+    size_t staging_buffer_len
+);
+
+/**
+ * @brief Same as ssd1306_init_transport, but for a transport accepting segmented transactions.
+ * Segments are never concatenated by the driver.
+ *
+ * @param writev Gather transport write function.
+ * @param user_data User data pointer passed to every write.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_init_transport_v(
+    ssd1306_transport_writev_t writev,
+    void* user_data
+);
+
+/**
+ * @brief Selects the display instance used by all API calls made from the calling core.
+ * Every core starts with the same default instance, so single display applications never call it.
+ * Instances selected on both cores at once must be driven over different I2C instances or transports.
+ *
+ * @param instance Pointer to the instance or NULL for the default instance.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_select_instance(
+    ssd1306_instance_t* instance
+);
+
+/**
+ * @brief Sets the function called at the end of every flush of the selected instance, e.g. ssd1306_recorder_mark_frame
+ * to mark frames in a recorded log. Cleared by initialization and deinitialization.
+ *
+ * @param hook Flush hook, NULL to drop it.
+ * @param user_data User data pointer passed to the hook.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_flush_hook(
+    ssd1306_flush_hook_t hook,
+    void* user_data
+);
+
+/**
+ * @brief Get the display instance selected on the calling core.
+ *
+ * @return Pointer to the selected instance.
+ */
+ssd1306_instance_t* ssd1306_get_instance();
+
+/**
+ * @brief Gets bus traffic counters accumulated since initialization or the last ssd1306_reset_stats.
+ *
+ * @param stats Pointer to store the counters.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_stats(
+    ssd1306_stats_t* stats
+);
+
+/**
+ * @brief Resets bus traffic counters.
+ *
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_reset_stats();
+
+/**
+ * @brief Estimates a percentile of a timing histogram, e.g. flush latency.
+ *
+ * @param hist Histogram of SSD1306_TIME_HIST_BUCKET_COUNT buckets.
+ * @param percent Percentile. [0, 100]
+ * @return Upper bound of the bucket holding the percentile in microseconds,
+ * lower bound for the last bucket, 0 for an empty histogram.
+ */
+uint32_t ssd1306_time_hist_percentile_us(
+    const uint32_t hist[],
+    uint percent
+);
+
+/**
+ * @brief Models wire time of a single I2C transaction:
+ * START, address byte, buffer_len bytes of SSD1306_I2C_CLOCKS_PER_BYTE clocks each, STOP and bus free time.
+ *
+ * @param buffer_len Number of bytes following the address byte, control byte included.
+ * @param freq_khz I2C clock frequency in kilohertz.
+ * @return Modeled time in nanoseconds.
+ */
+uint64_t ssd1306_model_i2c_txn_time_ns(
+    size_t buffer_len,
+    uint freq_khz
+);
+
+/**
+ * @brief Models wire time of all transactions counted in stats at any I2C clock frequency.
+ *
+ * @param stats Pointer to bus traffic counters.
+ * @param freq_khz I2C clock frequency in kilohertz.
+ * @return Modeled time in nanoseconds.
+ */
+uint64_t ssd1306_model_i2c_time_ns(
+    const ssd1306_stats_t* stats,
+    uint freq_khz
+);
+
+/**
+ * @brief Sets the I2C clock frequency used to communicate with the display.
+ *
+ * @param freq_khz The clock frequency in kilohertz [100, 1000].
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_i2c_clk_freq(
+    uint freq_khz
+);
+
+/**
+ * @brief Gets the I2C clock frequency currently used to communicate with the display.
+ * The value may be lower than the one set if automatic fallback took place.
+ *
+ * @param freq_khz Pointer to store the clock frequency in kilohertz.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_i2c_clk_freq(
+    uint* freq_khz
+);
+
+/**
+ * @brief Finds the fastest reliable I2C clock frequency.
+ * Steps the clock up from the minimum frequency to freq_max_khz by SSD1306_I2C_CLK_FREQ_STEP_KHZ,
+ * writing a harmless NOP command pattern SSD1306_I2C_CALIB_PROBE_COUNT times on each step.
+ * The first NAK or timeout stops the search and the last fully acknowledged frequency is kept.
+ *
+ * @param freq_max_khz The highest clock frequency to try in kilohertz [100, 1000].
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_calibrate_i2c_clk(
+    uint freq_max_khz
+);
+
+/**
+ * @brief Enables or disables automatic I2C clock fallback.
+ * When enabled, SSD1306_I2C_FALLBACK_ERR_THRESHOLD consecutive write errors
+ * lower the clock by SSD1306_I2C_CLK_FREQ_STEP_KHZ and the failed write is retried once.
+ * Fallback is enabled by default.
+ *
+ * @param is_enabled Fallback state.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_i2c_clk_fallback(
+    bool is_enabled
+);
+
+/**
+ * @brief Validates the configuration once and packs the whole power-up command sequence into a blob.
+ * The blob starts with the I2C command control byte and can be stored and sent repeatedly.
+ *
+ * @param config Pointer to the initialization configuration.
+ * @param blob Buffer of SSD1306_INIT_BLOB_SIZE bytes to store the commands.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_build_init_blob(
+    const ssd1306_init_config_t* config,
+    uint8_t blob[]
+);
+
+/**
+ * @brief Sends a command blob built by ssd1306_build_init_blob in a single I2C transaction.
+ * Commands at the SSD1306_INIT_BLOB_*_IDX positions are checked before the settings tracked by the driver are read from them.
+ *
+ * @param blob Buffer of SSD1306_INIT_BLOB_SIZE bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_send_init_blob(
+    const uint8_t blob[]
+);
+
+/**
+ * @brief Builds the initialization command blob and sends it in a single I2C transaction.
+ *
+ * @param config Pointer to the initialization configuration.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_init_display(
+    const ssd1306_init_config_t* config
+);
+
 /**
  * @brief Sends an array of RAM data to show.
+ * Page CRCs kept by ssd1306_flush are dropped, so the next flush sends all pages.
  *
  * @param data An array containing RAM (pixel) data.
  * @param data_len The length of the data array.
@@ -211,11 +714,163 @@ ssd1306_err_t ssd1306_send_data(
     size_t data_len
 );
 
+/**
+ * @brief Sends RAM data preceded by a reserved slot without copying it.
+ * The control byte is written into the slot, so the buffer goes to the transport as is.
+ * Page CRCs kept by ssd1306_flush are dropped, so the next flush sends all pages.
+ *
+ * @param buffer An array of SSD1306_PREFIX_SIZE + data_len bytes, RAM (pixel) data starts after the slot.
+ * @param data_len The length of RAM data, slot excluded.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_send_data_prefixed(
+    uint8_t buffer[], 
+    size_t data_len
+);
+
+
+/**
+ * @brief Sends RAM data gathered from several segments in a single transaction.
+ * Page CRCs kept by ssd1306_flush are dropped, so the next flush sends all pages.
+ *
+ * @param segments RAM (pixel) data segments.
+ * @param segment_count Number of segments. [1, SSD1306_IOVEC_MAX_COUNT]
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_send_data_v(
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+
+/**
+ * @brief Sets the RAM window and fills it with data gathered from several segments.
+ * Window commands take one short transaction and all segments a single data transaction,
+ * so e.g. rows of a flash-resident bitmap are sent without staging them in RAM.
+ * Page CRCs kept by ssd1306_flush are dropped for the pages of the window.
+ * With a row window set the pages must lie inside it, see ssd1306_set_row_window.
+ *
+ * @param page_start The first page of the window.
+ * @param page_end The last page of the window.
+ * @param col_start The first column of the window.
+ * @param col_end The last column of the window.
+ * @param segments RAM (pixel) data segments.
+ * @param segment_count Number of segments. [1, SSD1306_IOVEC_MAX_COUNT]
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_send_area_v(
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end,
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+
+/**
+ * @brief Sends a full page-major frame, skipping pages the display already holds.
+ * A CRC32 of every page is kept for what the display last received, unchanged pages are not sent.
+ * Consecutive changed pages are sent in one transaction. Requires horizontal memory addressing mode.
+ * On target CRCs are computed by the DMA sniffer when a free DMA channel is available and the sniffer
+ * is not busy on the other core, in software otherwise.
+ * With a row window set the frame covers only the window, see ssd1306_set_row_window.
+ *
+ * @param frame An array of SSD1306_WINDOW_FRAME_SIZE(window page count) bytes of RAM (pixel) data,
+ * SSD1306_RAM_BUFF_SIZE without a row window.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_flush(
+    const uint8_t frame[]
+);
+
+/**
+ * @brief Same as ssd1306_flush, but sends pages straight from a prefixed frame without copying.
+ * Frame starts after the reserved slot, e.g. a canvas over prefixed_frame + SSD1306_PREFIX_SIZE.
+ * A run of pages starting below the top borrows the last byte of the previous page as its slot
+ * and restores it once the transaction is done, so the frame must not be drawn during the flush.
+ *
+ * @param prefixed_frame An array of SSD1306_WINDOW_PREFIXED_FRAME_SIZE(window page count) bytes,
+ * SSD1306_PREFIXED_FRAME_SIZE without a row window.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_flush_prefixed(
+    uint8_t prefixed_frame[]
+);
+
+/**
+ * @brief Same as ssd1306_flush_prefixed, but sends changed pages one by one in the order the scan leaves them.
+ * The page the scan passed most recently goes first, so each page is written while the scan is away from it
+ * and an animated page is never shown half old and half new. Costs one window command per page.
+ * Scan position is estimated, see ssd1306_get_scan_row.
+ *
+ * @param prefixed_frame Same as for ssd1306_flush_prefixed.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_flush_paced(
+    uint8_t prefixed_frame[]
+);
+
+/**
+ * @brief Get the display frame period.
+ * Unless calibrated, it is estimated from the settings sent by the driver:
+ * Fosc / ((divide ratio + 1) * (phase 1 + phase 2 + SSD1306_BANK0_PULSE_DCLKS) * (mux ratio + 1)),
+ * Fosc being SSD1306_OSC_FREQ_KHZ scaled linearly by the oscillator frequency level.
+ *
+ * @param period_us Pointer to store the frame period in microseconds.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_frame_period_us(
+    uint32_t* period_us
+);
+
+/**
+ * @brief Overrides the estimated frame period with a measured one, e.g. from a camera recording of a scrolling pattern.
+ * Oscillator spreads about 10% between modules, so paced flushes of long animations drift without it.
+ *
+ * @param period_us Frame period in microseconds, 0 to go back to the estimate.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_calibrate_frame_period(
+    uint32_t period_us
+);
+
+/**
+ * @brief Get the RAM row the display is estimated to be scanning.
+ * Modules expose no frame sync, so the scan is assumed to restart every frame period
+ * since the timing settings were last sent, and display offset is ignored.
+ *
+ * @param row Pointer to store the RAM row.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_scan_row(
+    uint8_t* row
+);
+
+/**
+ * @brief Sends a rectangular area of a full page-major frame.
+ * Rows of the area are gathered into one data transaction.
+ * Page CRCs kept by ssd1306_flush are updated for full width areas and dropped otherwise.
+ * With a row window set the frame covers only the window and the area must lie inside it, see ssd1306_set_row_window.
+ *
+ * @param frame An array of SSD1306_WINDOW_FRAME_SIZE(window page count) bytes of RAM (pixel) data,
+ * SSD1306_RAM_BUFF_SIZE without a row window.
+ * @param page_start The first RAM page of the area.
+ * @param page_end The last RAM page of the area.
+ * @param col_start The first column of the area.
+ * @param col_end The last column of the area.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_flush_area(
+    const uint8_t frame[],
+    uint8_t page_start,
+    uint8_t page_end,
+    uint8_t col_start,
+    uint8_t col_end
+);
 
 /**
  * @brief Sets the contrast level of the SSD1306 display to the specified value.
  *
- * @param contrast The contrast level to set [0, 127].
+ * @param contrast The contrast level to set [0, 255].
  * @return API error code.
  */
 ssd1306_err_t ssd1306_set_contrast(
@@ -266,6 +921,56 @@ ssd1306_err_t ssd1306_power_off();
  */
 ssd1306_err_t ssd1306_power_on();
 
+/**
+ * @brief Puts the display to sleep: display off, then charge pump off.
+ * The SSD1306 retains RAM content while VDD is present, so no redraw is needed after ssd1306_wake.
+ *
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_sleep();
+
+/**
+ * @brief Wakes the display with a single short command transaction:
+ * charge pump on, fade-out off, full contrast restored and display on.
+ *
+ * @param is_ram_valid Pointer to store whether display RAM still holds the last sent content.
+ * If false, the caller has to send a full frame. May be NULL.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_wake(
+    bool* is_ram_valid
+);
+
+/**
+ * @brief Dims the display to one of the contrast stages.
+ * The stage is derived from the contrast set by ssd1306_set_contrast or ssd1306_init_display.
+ * For a gradual hardware fade use ssd1306_set_fade_out_mode, ssd1306_wake cancels it.
+ *
+ * @param level The dimming stage.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_dim_level(
+    ssd1306_dim_level_t level
+);
+
+/**
+ * @brief Gets the power state tracked by the power manager.
+ *
+ * @param power_state Pointer to store the power state.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_power_state(
+    ssd1306_power_state_t* power_state
+);
+
+/**
+ * @brief Marks display RAM content as lost, e.g. after the display supply was cut.
+ * RAM is considered valid again after the next RAM data write. The next ssd1306_flush sends all pages.
+ *
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_invalidate_ram();
+
 
 /**
  * @brief Setup continuous right horizontal scroll.
@@ -327,6 +1032,32 @@ ssd1306_err_t ssd1306_vh_scroll_left_setup(
     uint8_t row_offset
 );
 
+/**
+ * @brief Scrolls display RAM of a page range right by exactly one column, without activating continuous scroll.
+ * Page CRCs kept by ssd1306_flush are dropped for the scrolled pages.
+ *
+ * @param page_start Scroll start page address.
+ * @param page_end Scroll end page address.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_content_scroll_right(
+    uint8_t page_start,
+    uint8_t page_end
+);
+
+/**
+ * @brief Scrolls display RAM of a page range left by exactly one column, without activating continuous scroll.
+ * Page CRCs kept by ssd1306_flush are dropped for the scrolled pages.
+ *
+ * @param page_start Scroll start page address.
+ * @param page_end Scroll end page address.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_content_scroll_left(
+    uint8_t page_start,
+    uint8_t page_end
+);
+
 /**
  * @brief Disable scrolling.
  *
@@ -336,6 +1067,7 @@ ssd1306_err_t ssd1306_scroll_off();
 
 /**
  * @brief Enable scrolling.
+ * Scrolling alters display RAM, so the next ssd1306_flush sends all pages.
  *
  * @return API error code.
  */
@@ -421,6 +1153,7 @@ ssd1306_err_t ssd1306_set_display_start_line(
  * @brief Disable SEG hardware column address remap.
  * Column address 0 is mapped to SEG0.
  * Don't affect on already stored RAM data
+ * Becomes the base of ssd1306_set_orientation, which is reset to SSD1306_ORIENTATION_0.
  * 
  * @return API error code.
  */
@@ -430,6 +1163,7 @@ ssd1306_err_t ssd1306_seg_remap_off();
  * @brief Enable SEG hardware column address remap.
  * Column address 127 is mapped to SEG0.
  * Don't affect already stored RAM data.
+ * Becomes the base of ssd1306_set_orientation, which is reset to SSD1306_ORIENTATION_0.
  * 
  * @return API error code.
  */
@@ -449,6 +1183,7 @@ ssd1306_err_t ssd1306_set_mux_ratio(
  * @brief Disable COM output scan direction remap.
  * Scans from COM0 to COM[N-1], where N is multiplex ratio.
  * Display output is affected immediately.
+ * Becomes the base of ssd1306_set_orientation, which is reset to SSD1306_ORIENTATION_0.
  *
  * @return API error code.
  */
@@ -459,11 +1194,63 @@ ssd1306_err_t ssd1306_com_out_scan_remap_off();
  * @brief Enable COM output scan direction remap.
  * Scans from COM[N-1] to COM0, where N is multiplex ratio.
  * Display output is affected immediately.
+ * Becomes the base of ssd1306_set_orientation, which is reset to SSD1306_ORIENTATION_0.
  *
  * @return API error code.
  */
 ssd1306_err_t ssd1306_com_out_scan_remap_on();
 
+/**
+ * @brief Orients the display with SEG remap and COM scan direction, so no pixel is moved by the CPU.
+ * SEG remap doesn't affect already stored RAM data, so the next ssd1306_flush sends all pages.
+ *
+ * @param orientation Display orientation.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_orientation(
+    ssd1306_orientation_t orientation
+);
+
+/**
+ * @brief Get the display orientation set by ssd1306_set_orientation.
+ *
+ * @param orientation Pointer to store the display orientation.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_orientation(
+    ssd1306_orientation_t* orientation
+);
+
+/**
+ * @brief Limits the display to a window of whole pages, e.g. the top 2 pages for a status strip.
+ * Only the window rows are scanned: multiplex ratio is reduced to the window height, which raises
+ * the frame rate and lowers the current, and display offset keeps the window in its place on the panel.
+ * Rows outside the window stay dark. Flushes take frames of the window size and track only its pages.
+ * Overrides multiplex ratio, display offset and display start line, which must not be changed
+ * while a window is set. Panning with ssd1306_viewport_t needs the full window.
+ * Display offset is assumed to be 0 without a window.
+ *
+ * @param page_start The first page of the window.
+ * @param page_count Number of pages of the window. [SSD1306_MIN_WINDOW_PAGE_COUNT, SSD1306_PAGE_COUNT - page_start]
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_set_row_window(
+    uint8_t page_start,
+    uint8_t page_count
+);
+
+/**
+ * @brief Get the row window.
+ *
+ * @param page_start Pointer to store the first page of the window.
+ * @param page_count Pointer to store the number of pages of the window, SSD1306_PAGE_COUNT without a window.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_get_row_window(
+    uint8_t* page_start,
+    uint8_t* page_count
+);
+
 /**
  * @brief Vertical shift by COM from 0 to 63.
  * Maps COM0 with N-th row on display
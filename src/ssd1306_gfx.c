@@ -0,0 +1,1010 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "ssd1306_gfx.h"
+
+
+/**
+ * Run of adjacent columns sharing the same row span, filled as one rectangle.
+ */
+typedef struct ssd1306_gfx_span_run_t
+{
+    int x;
+    int w;
+    int y_start;
+    int y_end;
+}
+ssd1306_gfx_span_run_t;
+
+
+static int ssd1306_gfx_floor_div8(
+    int value
+);
+static uint8_t ssd1306_gfx_get_clip_mask(
+    const ssd1306_canvas_t* canvas,
+    int page
+);
+static void ssd1306_gfx_put_pixel(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    bool is_on
+);
+static void ssd1306_gfx_write_cols(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t cols[],
+    int count,
+    uint8_t src_mask
+);
+static void ssd1306_gfx_fill_page_run(
+    uint8_t row[],
+    int count,
+    uint8_t mask,
+    bool is_on
+);
+static void ssd1306_gfx_push_col_span(
+    ssd1306_canvas_t* canvas,
+    ssd1306_gfx_span_run_t* run,
+    int x,
+    int y_start,
+    int y_end,
+    bool is_on
+);
+static void ssd1306_gfx_flush_span_run(
+    ssd1306_canvas_t* canvas,
+    ssd1306_gfx_span_run_t* run,
+    bool is_on
+);
+static int ssd1306_gfx_isqrt(
+    int value
+);
+static int ssd1306_gfx_div_round(
+    int num,
+    int den
+);
+static int ssd1306_gfx_round_extent(
+    int w,
+    int r,
+    int col
+);
+static void ssd1306_gfx_rasterize_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_filled,
+    bool is_on
+);
+static void ssd1306_gfx_edge_rows(
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x,
+    int* y_min,
+    int* y_max
+);
+
+
+ssd1306_err_t ssd1306_canvas_init(
+    ssd1306_canvas_t* canvas,
+    uint8_t buffer[],
+    uint16_t width,
+    uint16_t height
+)
+{
+    if(canvas == NULL || buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(width == 0)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(height == 0 || height % SSD1306_PAGE_HEIGHT != 0)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    canvas->buffer = buffer;
+    canvas->width = width;
+    canvas->height = height;
+    canvas->clip.x_start = 0;
+    canvas->clip.y_start = 0;
+    canvas->clip.x_end = width;
+    canvas->clip.y_end = height;
+    canvas->clip_depth = 0;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_gfx_push_clip(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h
+)
+{
+    if(canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(canvas->clip_depth == SSD1306_GFX_CLIP_STACK_DEPTH)
+    {
+        return SSD1306_ERR_INVALID_CLIP_DEPTH;
+    }
+
+    canvas->clip_stack[canvas->clip_depth++] = canvas->clip;
+
+    if(!ssd1306_gfx_clip_area(canvas, &x, &y, &w, &h))
+    {
+        // Empty clip rejects everything
+        x = y = w = h = 0;
+    }
+
+    canvas->clip.x_start = x;
+    canvas->clip.y_start = y;
+    canvas->clip.x_end = x + w;
+    canvas->clip.y_end = y + h;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_gfx_pop_clip(
+    ssd1306_canvas_t* canvas
+)
+{
+    if(canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(canvas->clip_depth == 0)
+    {
+        return SSD1306_ERR_INVALID_CLIP_DEPTH;
+    }
+
+    canvas->clip = canvas->clip_stack[--canvas->clip_depth];
+
+    return SSD1306_ERR_OK;
+}
+
+bool ssd1306_gfx_clip_area(
+    const ssd1306_canvas_t* canvas,
+    int* x,
+    int* y,
+    int* w,
+    int* h
+)
+{
+    int x_start = *x > canvas->clip.x_start ? *x : canvas->clip.x_start;
+    int y_start = *y > canvas->clip.y_start ? *y : canvas->clip.y_start;
+    int x_end = *x + *w < canvas->clip.x_end ? *x + *w : canvas->clip.x_end;
+    int y_end = *y + *h < canvas->clip.y_end ? *y + *h : canvas->clip.y_end;
+
+    if(x_start >= x_end || y_start >= y_end)
+    {
+        return false;
+    }
+
+    *x = x_start;
+    *y = y_start;
+    *w = x_end - x_start;
+    *h = y_end - y_start;
+
+    return true;
+}
+
+void ssd1306_gfx_clear(
+    ssd1306_canvas_t* canvas,
+    bool is_on
+)
+{
+    const ssd1306_clip_t* clip = &canvas->clip;
+
+    if(clip->x_start == 0 && clip->y_start == 0 && clip->x_end == canvas->width && clip->y_end == canvas->height)
+    {
+        memset(canvas->buffer, is_on ? 0xFF : 0x00, canvas->width * (canvas->height / SSD1306_PAGE_HEIGHT));
+        return;
+    }
+
+    ssd1306_gfx_fill_rect(canvas, clip->x_start, clip->y_start, clip->x_end - clip->x_start, clip->y_end - clip->y_start, is_on);
+}
+
+int ssd1306_gfx_floor_div8(
+    int value
+)
+{
+    return value >= 0 ? value / 8 : -((-value + 7) / 8);
+}
+
+uint8_t ssd1306_gfx_get_clip_mask(
+    const ssd1306_canvas_t* canvas,
+    int page
+)
+{
+    int row_start = page * SSD1306_PAGE_HEIGHT;
+    int row_end = row_start + SSD1306_PAGE_HEIGHT;
+
+    if(row_start >= canvas->clip.y_end || row_end <= canvas->clip.y_start)
+    {
+        return 0;
+    }
+
+    uint8_t mask = 0xFF;
+
+    if(canvas->clip.y_start > row_start)
+    {
+        mask &= 0xFF << (canvas->clip.y_start - row_start);
+    }
+    if(canvas->clip.y_end < row_end)
+    {
+        mask &= 0xFF >> (row_end - canvas->clip.y_end);
+    }
+
+    return mask;
+}
+
+void ssd1306_gfx_put_pixel(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    bool is_on
+)
+{
+    uint8_t* byte = &canvas->buffer[(y / SSD1306_PAGE_HEIGHT) * canvas->width + x];
+    uint8_t bit = 1 << (y % SSD1306_PAGE_HEIGHT);
+
+    if(is_on)
+    {
+        *byte |= bit;
+    }
+    else
+    {
+        *byte &= ~bit;
+    }
+}
+
+void ssd1306_gfx_set_pixel(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    bool is_on
+)
+{
+    if(x < canvas->clip.x_start || x >= canvas->clip.x_end || y < canvas->clip.y_start || y >= canvas->clip.y_end)
+    {
+        return;
+    }
+
+    ssd1306_gfx_put_pixel(canvas, x, y, is_on);
+}
+
+bool ssd1306_gfx_get_pixel(
+    const ssd1306_canvas_t* canvas,
+    int x,
+    int y
+)
+{
+    if(x < 0 || x >= canvas->width || y < 0 || y >= canvas->height)
+    {
+        return false;
+    }
+
+    return canvas->buffer[(y / SSD1306_PAGE_HEIGHT) * canvas->width + x] & (1 << (y % SSD1306_PAGE_HEIGHT));
+}
+
+void ssd1306_gfx_draw_line(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    bool is_on
+)
+{
+    int dx =  abs(x1 - x0);
+    int sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0);
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    int e2;
+
+    int x_min = x0 < x1 ? x0 : x1;
+    int y_min = y0 < y1 ? y0 : y1;
+
+    if(dy == 0 || dx == 0)
+    {
+        ssd1306_gfx_fill_rect(canvas, x_min, y_min, dx + 1, -dy + 1, is_on);
+        return;
+    }
+
+    // Line bounding box decides once whether pixels need clipping
+    int bbox_x = x_min;
+    int bbox_y = y_min;
+    int bbox_w = dx + 1;
+    int bbox_h = -dy + 1;
+
+    if(!ssd1306_gfx_clip_area(canvas, &bbox_x, &bbox_y, &bbox_w, &bbox_h))
+    {
+        return;
+    }
+
+    bool is_inside = bbox_w == dx + 1 && bbox_h == -dy + 1;
+
+    while (true)
+    {
+        if(is_inside)
+        {
+            ssd1306_gfx_put_pixel(canvas, x0, y0, is_on);
+        }
+        else
+        {
+            ssd1306_gfx_set_pixel(canvas, x0, y0, is_on);
+        }
+
+        if (x0 == x1 && y0 == y1)
+        {
+            break;
+        }
+
+        e2 = 2 * err;
+
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ssd1306_gfx_fill_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    bool is_on
+)
+{
+    if(!ssd1306_gfx_clip_area(canvas, &x, &y, &w, &h))
+    {
+        return;
+    }
+
+    int x_end = x + w;
+    int y_end = y + h;
+    int page_start = y / SSD1306_PAGE_HEIGHT;
+    int page_end = (y_end - 1) / SSD1306_PAGE_HEIGHT;
+
+    for(int page = page_start; page <= page_end; ++page)
+    {
+        uint8_t mask = 0xFF;
+
+        if(page == page_start)
+        {
+            mask &= 0xFF << (y % SSD1306_PAGE_HEIGHT);
+        }
+        if(page == page_end)
+        {
+            mask &= 0xFF >> (SSD1306_PAGE_HEIGHT - 1 - (y_end - 1) % SSD1306_PAGE_HEIGHT);
+        }
+
+        ssd1306_gfx_fill_page_run(&canvas->buffer[page * canvas->width + x], x_end - x, mask, is_on);
+    }
+}
+
+void ssd1306_gfx_fill_page_run(
+    uint8_t row[],
+    int count,
+    uint8_t mask,
+    bool is_on
+)
+{
+    if(mask == 0xFF)
+    {
+        memset(row, is_on ? 0xFF : 0x00, count);
+        return;
+    }
+
+    uint32_t word_mask = mask * 0x01010101u;
+    int col = 0;
+
+    // Bytes up to the first word boundary, then 4 columns per word
+    for(; col < count && ((uintptr_t)&row[col] & 3) != 0; ++col)
+    {
+        row[col] = is_on ? (row[col] | mask) : (row[col] & ~mask);
+    }
+
+    for(; col + 4 <= count; col += 4)
+    {
+        uint32_t word;
+
+        memcpy(&word, &row[col], sizeof(word));
+        word = is_on ? (word | word_mask) : (word & ~word_mask);
+        memcpy(&row[col], &word, sizeof(word));
+    }
+
+    for(; col < count; ++col)
+    {
+        row[col] = is_on ? (row[col] | mask) : (row[col] & ~mask);
+    }
+}
+
+void ssd1306_gfx_draw_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    bool is_on
+)
+{
+    if(w <= 0 || h <= 0)
+    {
+        return;
+    }
+
+    ssd1306_gfx_fill_rect(canvas, x, y, w, 1, is_on);
+    ssd1306_gfx_fill_rect(canvas, x, y + h - 1, w, 1, is_on);
+    ssd1306_gfx_fill_rect(canvas, x, y, 1, h, is_on);
+    ssd1306_gfx_fill_rect(canvas, x + w - 1, y, 1, h, is_on);
+}
+
+void ssd1306_gfx_push_col_span(
+    ssd1306_canvas_t* canvas,
+    ssd1306_gfx_span_run_t* run,
+    int x,
+    int y_start,
+    int y_end,
+    bool is_on
+)
+{
+    if(run->w > 0 && x == run->x + run->w && y_start == run->y_start && y_end == run->y_end)
+    {
+        ++run->w;
+        return;
+    }
+
+    ssd1306_gfx_flush_span_run(canvas, run, is_on);
+
+    run->x = x;
+    run->w = 1;
+    run->y_start = y_start;
+    run->y_end = y_end;
+}
+
+void ssd1306_gfx_flush_span_run(
+    ssd1306_canvas_t* canvas,
+    ssd1306_gfx_span_run_t* run,
+    bool is_on
+)
+{
+    if(run->w > 0)
+    {
+        ssd1306_gfx_fill_rect(canvas, run->x, run->y_start, run->w, run->y_end - run->y_start, is_on);
+        run->w = 0;
+    }
+}
+
+int ssd1306_gfx_isqrt(
+    int value
+)
+{
+    unsigned int rest = value;
+    unsigned int root = 0;
+    unsigned int bit = 1u << 30;
+
+    while(bit > rest)
+    {
+        bit >>= 2;
+    }
+
+    while(bit != 0)
+    {
+        if(rest >= root + bit)
+        {
+            rest -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+int ssd1306_gfx_div_round(
+    int num,
+    int den
+)
+{
+    int q = 2 * num + den;
+    int d = 2 * den;
+
+    return q >= 0 ? q / d : -((-q + d - 1) / d);
+}
+
+int ssd1306_gfx_round_extent(
+    int w,
+    int r,
+    int col
+)
+{
+    // Corner columns are dx away from the corner circle center, columns between the corners have dx 0
+    int dx = col < r ? r - col : (col > w - 1 - r ? col - (w - 1 - r) : 0);
+
+    if(col < 0 || col >= w)
+    {
+        return -1;
+    }
+
+    // Pixel centers inside a circle of radius r + 1/2
+    return ssd1306_gfx_isqrt(r * r + r - dx * dx);
+}
+
+void ssd1306_gfx_rasterize_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_filled,
+    bool is_on
+)
+{
+    if(w <= 0 || h <= 0)
+    {
+        return;
+    }
+
+    r = r < 0 ? 0 : r;
+    r = r > (w - 1) / 2 ? (w - 1) / 2 : r;
+    r = r > (h - 1) / 2 ? (h - 1) / 2 : r;
+
+    ssd1306_gfx_span_run_t top_run = {0};
+    ssd1306_gfx_span_run_t bottom_run = {0};
+    int col_start = canvas->clip.x_start - x > 0 ? canvas->clip.x_start - x : 0;
+    int col_end = canvas->clip.x_end - x < w ? canvas->clip.x_end - x : w;
+
+    // Every column is one vertical span, or two for the outline: from its top down to the top of its
+    // lower neighbour, at least one pixel, so the outline stays connected, and the same at the bottom
+    for(int col = col_start; col < col_end; ++col)
+    {
+        int extent = ssd1306_gfx_round_extent(w, r, col);
+        int y_top = y + r - extent;
+        int y_bottom = y + h - 1 - r + extent;
+
+        if(is_filled)
+        {
+            ssd1306_gfx_push_col_span(canvas, &top_run, x + col, y_top, y_bottom + 1, is_on);
+            continue;
+        }
+
+        int prev_extent = ssd1306_gfx_round_extent(w, r, col - 1);
+        int next_extent = ssd1306_gfx_round_extent(w, r, col + 1);
+        int len = extent - (prev_extent < next_extent ? prev_extent : next_extent);
+
+        // Left and right sides are whole columns
+        if(prev_extent < 0 || next_extent < 0)
+        {
+            ssd1306_gfx_push_col_span(canvas, &top_run, x + col, y_top, y_bottom + 1, is_on);
+            continue;
+        }
+
+        len = len < 1 ? 1 : len;
+
+        ssd1306_gfx_push_col_span(canvas, &top_run, x + col, y_top, y_top + len, is_on);
+        ssd1306_gfx_push_col_span(canvas, &bottom_run, x + col, y_bottom + 1 - len, y_bottom + 1, is_on);
+    }
+
+    ssd1306_gfx_flush_span_run(canvas, &top_run, is_on);
+    ssd1306_gfx_flush_span_run(canvas, &bottom_run, is_on);
+}
+
+void ssd1306_gfx_fill_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_on
+)
+{
+    ssd1306_gfx_rasterize_round_rect(canvas, x, y, w, h, r, true, is_on);
+}
+
+void ssd1306_gfx_draw_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_on
+)
+{
+    ssd1306_gfx_rasterize_round_rect(canvas, x, y, w, h, r, false, is_on);
+}
+
+void ssd1306_gfx_fill_circle(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int r,
+    bool is_on
+)
+{
+    ssd1306_gfx_rasterize_round_rect(canvas, x - r, y - r, 2 * r + 1, 2 * r + 1, r, true, is_on);
+}
+
+void ssd1306_gfx_draw_circle(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int r,
+    bool is_on
+)
+{
+    ssd1306_gfx_rasterize_round_rect(canvas, x - r, y - r, 2 * r + 1, 2 * r + 1, r, false, is_on);
+}
+
+void ssd1306_gfx_edge_rows(
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x,
+    int* y_min,
+    int* y_max
+)
+{
+    int y_a = y0;
+    int y_b = y1;
+
+    // Rows the edge crosses within the column, from x - 1/2 to x + 1/2 cut to the edge ends
+    if(x0 != x1)
+    {
+        int half_start = 2 * x - 1 > 2 * x0 ? 2 * x - 1 : 2 * x0;
+        int half_end = 2 * x + 1 < 2 * x1 ? 2 * x + 1 : 2 * x1;
+
+        y_a = y0 + ssd1306_gfx_div_round((y1 - y0) * (half_start - 2 * x0), 2 * (x1 - x0));
+        y_b = y0 + ssd1306_gfx_div_round((y1 - y0) * (half_end - 2 * x0), 2 * (x1 - x0));
+    }
+
+    *y_min = y_a < y_b ? y_a : y_b;
+    *y_max = y_a > y_b ? y_a : y_b;
+}
+
+void ssd1306_gfx_fill_triangle(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x2,
+    int y2,
+    bool is_on
+)
+{
+    int t;
+
+    // Vertices from left to right
+    if(x0 > x1)
+    {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    if(x1 > x2)
+    {
+        t = x1; x1 = x2; x2 = t;
+        t = y1; y1 = y2; y2 = t;
+    }
+    if(x0 > x1)
+    {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+
+    ssd1306_gfx_span_run_t run = {0};
+    int x_start = x0 > canvas->clip.x_start ? x0 : canvas->clip.x_start;
+    int x_end = x2 < canvas->clip.x_end - 1 ? x2 : canvas->clip.x_end - 1;
+
+    // Convex, so every column is one span between the rows of the edges crossing it
+    for(int x = x_start; x <= x_end; ++x)
+    {
+        int y_min;
+        int y_max;
+        int edge_min;
+        int edge_max;
+
+        ssd1306_gfx_edge_rows(x0, y0, x2, y2, x, &y_min, &y_max);
+
+        if(x <= x1)
+        {
+            ssd1306_gfx_edge_rows(x0, y0, x1, y1, x, &edge_min, &edge_max);
+            y_min = edge_min < y_min ? edge_min : y_min;
+            y_max = edge_max > y_max ? edge_max : y_max;
+        }
+        if(x >= x1)
+        {
+            ssd1306_gfx_edge_rows(x1, y1, x2, y2, x, &edge_min, &edge_max);
+            y_min = edge_min < y_min ? edge_min : y_min;
+            y_max = edge_max > y_max ? edge_max : y_max;
+        }
+
+        ssd1306_gfx_push_col_span(canvas, &run, x, y_min, y_max + 1, is_on);
+    }
+
+    ssd1306_gfx_flush_span_run(canvas, &run, is_on);
+}
+
+void ssd1306_gfx_draw_triangle(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x2,
+    int y2,
+    bool is_on
+)
+{
+    ssd1306_gfx_draw_line(canvas, x0, y0, x1, y1, is_on);
+    ssd1306_gfx_draw_line(canvas, x1, y1, x2, y2, is_on);
+    ssd1306_gfx_draw_line(canvas, x2, y2, x0, y0, is_on);
+}
+
+void ssd1306_gfx_draw_polyline(
+    ssd1306_canvas_t* canvas,
+    const ssd1306_point_t points[],
+    size_t point_count,
+    bool is_on
+)
+{
+    for(size_t i = 1; i < point_count; ++i)
+    {
+        ssd1306_gfx_draw_line(canvas, points[i - 1].x, points[i - 1].y, points[i].x, points[i].y, is_on);
+    }
+}
+
+void ssd1306_gfx_write_cols(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t cols[],
+    int count,
+    uint8_t src_mask
+)
+{
+    // Column bytes land on up to two canvas pages, both clipped once for the whole run
+    int dst_page = ssd1306_gfx_floor_div8(y);
+    int shift = y - dst_page * SSD1306_PAGE_HEIGHT;
+    uint16_t clip_mask = ssd1306_gfx_get_clip_mask(canvas, dst_page) | (uint16_t)ssd1306_gfx_get_clip_mask(canvas, dst_page + 1) << 8;
+    uint16_t mask = ((uint16_t)src_mask << shift) & clip_mask;
+
+    int col_start = x < canvas->clip.x_start ? canvas->clip.x_start - x : 0;
+    int col_end = x + count > canvas->clip.x_end ? canvas->clip.x_end - x : count;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        uint8_t page_mask = mask >> (i * 8);
+
+        if(page_mask == 0)
+        {
+            continue;
+        }
+
+        uint8_t* row = &canvas->buffer[(dst_page + i) * canvas->width];
+
+        for(int col = col_start; col < col_end; ++col)
+        {
+            uint8_t bits = ((uint16_t)cols[col] << shift) >> (i * 8);
+            row[x + col] = (row[x + col] & ~page_mask) | (bits & page_mask);
+        }
+    }
+}
+
+void ssd1306_gfx_draw_bitmap(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t bitmap[],
+    int w,
+    int h
+)
+{
+    int src_page_count = (h + SSD1306_PAGE_HEIGHT - 1) / SSD1306_PAGE_HEIGHT;
+
+    for(int src_page = 0; src_page < src_page_count; ++src_page)
+    {
+        int rows = h - src_page * SSD1306_PAGE_HEIGHT;
+        uint8_t src_mask = rows >= SSD1306_PAGE_HEIGHT ? 0xFF : (1 << rows) - 1;
+
+        ssd1306_gfx_write_cols(canvas, x, y + src_page * SSD1306_PAGE_HEIGHT, &bitmap[src_page * w], w, src_mask);
+    }
+}
+
+void ssd1306_gfx_transpose8x8(
+    const uint8_t rows[],
+    size_t stride,
+    uint8_t cols[]
+)
+{
+    // Bottom row goes to the MSB end, so bit 0 of every column ends up being the top row
+    uint32_t hi = (uint32_t)rows[7 * stride] << 24 | (uint32_t)rows[6 * stride] << 16 | (uint32_t)rows[5 * stride] << 8 | rows[4 * stride];
+    uint32_t lo = (uint32_t)rows[3 * stride] << 24 | (uint32_t)rows[2 * stride] << 16 | (uint32_t)rows[stride] << 8 | rows[0];
+    uint32_t t;
+
+    // Swap 1x1, 2x2 and 4x4 bit blocks across the diagonal
+    t = (hi ^ (hi >> 7)) & 0x00AA00AA;
+    hi = hi ^ t ^ (t << 7);
+    t = (lo ^ (lo >> 7)) & 0x00AA00AA;
+    lo = lo ^ t ^ (t << 7);
+
+    t = (hi ^ (hi >> 14)) & 0x0000CCCC;
+    hi = hi ^ t ^ (t << 14);
+    t = (lo ^ (lo >> 14)) & 0x0000CCCC;
+    lo = lo ^ t ^ (t << 14);
+
+    t = (hi & 0xF0F0F0F0) | ((lo >> 4) & 0x0F0F0F0F);
+    lo = ((hi << 4) & 0xF0F0F0F0) | (lo & 0x0F0F0F0F);
+    hi = t;
+
+    cols[0] = hi >> 24;
+    cols[1] = hi >> 16;
+    cols[2] = hi >> 8;
+    cols[3] = hi;
+    cols[4] = lo >> 24;
+    cols[5] = lo >> 16;
+    cols[6] = lo >> 8;
+    cols[7] = lo;
+}
+
+void ssd1306_gfx_blit_rowmajor(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t bitmap[],
+    int w,
+    int h
+)
+{
+    int stride = (w + 7) / 8;
+    int src_page_count = (h + SSD1306_PAGE_HEIGHT - 1) / SSD1306_PAGE_HEIGHT;
+
+    // Blocks left of the clip rectangle are not transposed
+    int block_start = x < canvas->clip.x_start ? (canvas->clip.x_start - x) / 8 : 0;
+
+    for(int src_page = 0; src_page < src_page_count; ++src_page)
+    {
+        int rows = h - src_page * SSD1306_PAGE_HEIGHT;
+        int dst_y = y + src_page * SSD1306_PAGE_HEIGHT;
+        uint8_t src_mask = rows >= SSD1306_PAGE_HEIGHT ? 0xFF : (1 << rows) - 1;
+        const uint8_t* src = &bitmap[src_page * SSD1306_PAGE_HEIGHT * stride];
+
+        if(dst_y >= canvas->clip.y_end || dst_y + SSD1306_PAGE_HEIGHT <= canvas->clip.y_start)
+        {
+            continue;
+        }
+
+        for(int block = block_start; block < stride && x + block * 8 < canvas->clip.x_end; ++block)
+        {
+            uint8_t block_rows[SSD1306_PAGE_HEIGHT] = {0};
+            uint8_t cols[8];
+
+            // Rows past the bitmap bottom are never read
+            for(int row = 0; row < SSD1306_PAGE_HEIGHT && row < rows; ++row)
+            {
+                block_rows[row] = src[row * stride + block];
+            }
+
+            ssd1306_gfx_transpose8x8(block_rows, 1, cols);
+            ssd1306_gfx_write_cols(canvas, x + block * 8, dst_y, cols, w - block * 8 < 8 ? w - block * 8 : 8, src_mask);
+        }
+    }
+}
+
+ssd1306_err_t ssd1306_gfx_transpose_area(
+    const ssd1306_canvas_t* src,
+    ssd1306_canvas_t* dst,
+    int x,
+    int y,
+    int w,
+    int h
+)
+{
+    if(src == NULL || dst == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(src->width % SSD1306_PAGE_HEIGHT != 0 || dst->height != src->width)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+    if(dst->width != src->height)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+
+    int x_end = x + w;
+    int y_end = y + h;
+
+    x = x < 0 ? 0 : x;
+    y = y < 0 ? 0 : y;
+    x_end = x_end > src->width ? src->width : x_end;
+    y_end = y_end > src->height ? src->height : y_end;
+
+    if(x >= x_end || y >= y_end)
+    {
+        return SSD1306_ERR_OK;
+    }
+
+    // Block of 8 columns of a source page becomes 8 columns of a destination page
+    for(int src_page = y / SSD1306_PAGE_HEIGHT; src_page <= (y_end - 1) / SSD1306_PAGE_HEIGHT; ++src_page)
+    {
+        for(int block = x / 8; block <= (x_end - 1) / 8; ++block)
+        {
+            uint8_t cols[8];
+            uint8_t* dst_cols = &dst->buffer[block * dst->width + src_page * SSD1306_PAGE_HEIGHT];
+
+            ssd1306_gfx_transpose8x8(&src->buffer[src_page * src->width + block * 8], 1, cols);
+
+            // Transpose kernel reads the MSB as the leftmost pixel, so columns come out right to left
+            for(int col = 0; col < 8; ++col)
+            {
+                dst_cols[col] = cols[7 - col];
+            }
+        }
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+void ssd1306_gfx_draw_char(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_font_t* font,
+    uint8_t character
+)
+{
+    size_t glyph_idx = font->get_glyph_idx(character);
+
+    ssd1306_gfx_draw_bitmap(
+        canvas, x, y,
+        &font->glyphs[glyph_idx * font->glyph_width],
+        font->glyph_width,
+        SSD1306_PAGE_HEIGHT
+    );
+}
+
+void ssd1306_gfx_draw_str(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_font_t* font,
+    const char* str
+)
+{
+    for(size_t i = 0; str[i] != 0 && x < canvas->clip.x_end; ++i)
+    {
+        ssd1306_gfx_draw_char(canvas, x, y, font, str[i]);
+        x += font->glyph_width;
+    }
+}
@@ -0,0 +1,492 @@
+/**
+ *
+ *  @file
+ *  @brief Drawing primitives for page-major framebuffers
+ *
+ **/
+
+#ifndef SSD1306_GFX_H
+#define SSD1306_GFX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+
+/**
+ * @def SSD1306_GFX_CLIP_STACK_DEPTH
+ * @brief Maximum number of clip rectangles saved by ssd1306_gfx_push_clip.
+ */
+#define SSD1306_GFX_CLIP_STACK_DEPTH    _u(4)
+
+
+/**
+ * @struct ssd1306_clip_t
+ * @brief Clip rectangle inside a canvas, end column and end row excluded.
+ */
+typedef struct ssd1306_clip_t
+{
+    uint16_t x_start;   /**< First column. */
+    uint16_t y_start;   /**< First row. */
+    uint16_t x_end;     /**< Column after the last one. */
+    uint16_t y_end;     /**< Row after the last one. */
+}
+ssd1306_clip_t;
+
+/**
+ * @struct ssd1306_point_t
+ * @brief Point of a canvas.
+ */
+typedef struct ssd1306_point_t
+{
+    int16_t x;  /**< Column. */
+    int16_t y;  /**< Row. */
+}
+ssd1306_point_t;
+
+/**
+ * @struct ssd1306_canvas_t
+ * @brief Page-major 1 bpp drawing surface, laid out the same way as display RAM.
+ * Each byte holds 8 vertical pixels, LSB is the top one.
+ * Pages of width bytes follow each other from top to bottom.
+ */
+typedef struct ssd1306_canvas_t
+{
+    uint8_t* buffer;    /**< Pixel data, width * height / 8 bytes. */
+    uint16_t width;     /**< Width in pixels. */
+    uint16_t height;    /**< Height in pixels, multiple of SSD1306_PAGE_HEIGHT. */
+    ssd1306_clip_t clip;                                        /**< Area drawing primitives write to. */
+    ssd1306_clip_t clip_stack[SSD1306_GFX_CLIP_STACK_DEPTH];    /**< Clip rectangles saved by ssd1306_gfx_push_clip. */
+    uint8_t clip_depth;                                         /**< Number of saved clip rectangles. */
+}
+ssd1306_canvas_t;
+
+/**
+ * @struct ssd1306_font_t
+ * @brief Fixed width font made of page-major glyphs SSD1306_PAGE_HEIGHT pixels high.
+ */
+typedef struct ssd1306_font_t
+{
+    const uint8_t* glyphs;                          /**< Glyph bitmaps, glyph_width bytes each. */
+    uint8_t glyph_width;                            /**< Glyph width in pixels. */
+    size_t (*get_glyph_idx)(uint8_t character);     /**< Maps a character to its glyph index. */
+}
+ssd1306_font_t;
+
+
+/**
+ * @brief Initializes a canvas over a caller provided buffer. Clip rectangle covers the whole canvas.
+ *
+ * @param canvas Pointer to the canvas to initialize.
+ * @param buffer Pixel buffer of width * height / 8 bytes.
+ * @param width Width in pixels.
+ * @param height Height in pixels, multiple of SSD1306_PAGE_HEIGHT.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_canvas_init(
+    ssd1306_canvas_t* canvas,
+    uint8_t buffer[],
+    uint16_t width,
+    uint16_t height
+);
+
+/**
+ * @brief Saves the clip rectangle and narrows it down to its intersection with an area.
+ * Primitives clip their rows and column runs once against the rectangle, so off-clip parts cost nothing
+ * and partially visible glyphs and bitmaps show their visible part.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column of the area.
+ * @param y Top row of the area.
+ * @param w Width of the area in pixels.
+ * @param h Height of the area in pixels.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_gfx_push_clip(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h
+);
+
+/**
+ * @brief Restores the clip rectangle saved by the last ssd1306_gfx_push_clip.
+ *
+ * @param canvas Pointer to the canvas.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_gfx_pop_clip(
+    ssd1306_canvas_t* canvas
+);
+
+/**
+ * @brief Clips an area to the clip rectangle, e.g. to bound damage tracking by what primitives may have drawn.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Pointer to the left column of the area, updated.
+ * @param y Pointer to the top row of the area, updated.
+ * @param w Pointer to the width of the area, updated.
+ * @param h Pointer to the height of the area, updated.
+ * @return Whether any part of the area is left.
+ */
+bool ssd1306_gfx_clip_area(
+    const ssd1306_canvas_t* canvas,
+    int* x,
+    int* y,
+    int* w,
+    int* h
+);
+
+/**
+ * @brief Sets all pixels in the clip rectangle to the same value.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_clear(
+    ssd1306_canvas_t* canvas,
+    bool is_on
+);
+
+/**
+ * @brief Sets a single pixel. Pixels outside the clip rectangle are ignored.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Column.
+ * @param y Row.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_set_pixel(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    bool is_on
+);
+
+/**
+ * @brief Gets a single pixel. Pixels outside the canvas read as off.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Column.
+ * @param y Row.
+ * @return Pixel value.
+ */
+bool ssd1306_gfx_get_pixel(
+    const ssd1306_canvas_t* canvas,
+    int x,
+    int y
+);
+
+/**
+ * @brief Draws a line using Bresenham's algorithm.
+ * Horizontal and vertical lines are filled as rectangles, lines inside the clip rectangle skip per pixel checks.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x0 Start column.
+ * @param y0 Start row.
+ * @param x1 End column.
+ * @param y1 End row.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_line(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    bool is_on
+);
+
+/**
+ * @brief Fills a rectangle. Whole bytes are written for every column of a page,
+ * 4 columns per word where only some rows of a page change, memset where all of them do.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_fill_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    bool is_on
+);
+
+/**
+ * @brief Draws a rectangle outline.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    bool is_on
+);
+
+/**
+ * @brief Fills a rectangle with rounded corners.
+ * Shapes are rasterized into vertical spans, one per column, adjacent columns with the same span
+ * are filled as one rectangle. Corners are quarters of the circle drawn by ssd1306_gfx_fill_circle.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param r Corner radius, reduced to fit the rectangle.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_fill_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_on
+);
+
+/**
+ * @brief Draws the outline of a rectangle with rounded corners, the edge of ssd1306_gfx_fill_round_rect.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param r Corner radius, reduced to fit the rectangle.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_round_rect(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int w,
+    int h,
+    int r,
+    bool is_on
+);
+
+/**
+ * @brief Fills a circle: pixels with centers closer than r + 1/2 to the center.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Center column.
+ * @param y Center row.
+ * @param r Radius in pixels.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_fill_circle(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int r,
+    bool is_on
+);
+
+/**
+ * @brief Draws the outline of a circle, the edge of ssd1306_gfx_fill_circle.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Center column.
+ * @param y Center row.
+ * @param r Radius in pixels.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_circle(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    int r,
+    bool is_on
+);
+
+/**
+ * @brief Fills a triangle. Every column is filled between the rows its edges cross.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x0 First vertex column.
+ * @param y0 First vertex row.
+ * @param x1 Second vertex column.
+ * @param y1 Second vertex row.
+ * @param x2 Third vertex column.
+ * @param y2 Third vertex row.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_fill_triangle(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x2,
+    int y2,
+    bool is_on
+);
+
+/**
+ * @brief Draws a triangle outline.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x0 First vertex column.
+ * @param y0 First vertex row.
+ * @param x1 Second vertex column.
+ * @param y1 Second vertex row.
+ * @param x2 Third vertex column.
+ * @param y2 Third vertex row.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_triangle(
+    ssd1306_canvas_t* canvas,
+    int x0,
+    int y0,
+    int x1,
+    int y1,
+    int x2,
+    int y2,
+    bool is_on
+);
+
+/**
+ * @brief Draws lines joining consecutive points. Repeat the first point at the end to close the shape.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param points Points to join.
+ * @param point_count Number of points.
+ * @param is_on Pixel value.
+ */
+void ssd1306_gfx_draw_polyline(
+    ssd1306_canvas_t* canvas,
+    const ssd1306_point_t points[],
+    size_t point_count,
+    bool is_on
+);
+
+/**
+ * @brief Copies a page-major bitmap, e.g. raspberry26x32, to any position.
+ * Bitmap pixels overwrite canvas pixels, the bitmap is clipped by the clip rectangle.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param bitmap Page-major bitmap data, w * ceil(h / 8) bytes.
+ * @param w Bitmap width in pixels.
+ * @param h Bitmap height in pixels.
+ */
+void ssd1306_gfx_draw_bitmap(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t bitmap[],
+    int w,
+    int h
+);
+
+/**
+ * @brief Transposes an 8x8 bit matrix from row-major to page-major.
+ * Source rows hold their leftmost pixel in the MSB, destination columns hold their top pixel in the LSB.
+ *
+ * @param rows 8 source rows, each one stride bytes after the previous one.
+ * @param stride Distance between source rows in bytes.
+ * @param cols Buffer to store 8 page-major columns, leftmost first.
+ */
+void ssd1306_gfx_transpose8x8(
+    const uint8_t rows[],
+    size_t stride,
+    uint8_t cols[]
+);
+
+/**
+ * @brief Same as ssd1306_gfx_draw_bitmap, but for a row-major bitmap as emitted by most image tools, e.g. XBM with MSB first.
+ * Bitmap is converted on the fly by 8x8 blocks, so it never needs a page-major copy.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param bitmap Row-major bitmap data, ceil(w / 8) * h bytes, leftmost pixel of a byte in the MSB.
+ * @param w Bitmap width in pixels.
+ * @param h Bitmap height in pixels.
+ */
+void ssd1306_gfx_blit_rowmajor(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const uint8_t bitmap[],
+    int w,
+    int h
+);
+
+/**
+ * @brief Transposes an area of a canvas into a canvas of swapped dimensions, column x of src becoming row x of dst.
+ * Used with SSD1306_ORIENTATION_90 and SSD1306_ORIENTATION_270, which mirror the transposed frame in hardware:
+ * drawing goes to a portrait canvas, only its redrawn area is transposed into the display frame before the flush.
+ * Whole 8x8 blocks covering the area are transposed.
+ *
+ * @param src Pointer to the source canvas, width multiple of 8.
+ * @param dst Pointer to the destination canvas, src->height wide and src->width high.
+ * @param x Left column of the area in src.
+ * @param y Top row of the area in src.
+ * @param w Width of the area in pixels.
+ * @param h Height of the area in pixels.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_gfx_transpose_area(
+    const ssd1306_canvas_t* src,
+    ssd1306_canvas_t* dst,
+    int x,
+    int y,
+    int w,
+    int h
+);
+
+/**
+ * @brief Draws a single glyph.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param font Pointer to the font.
+ * @param character Character to draw.
+ */
+void ssd1306_gfx_draw_char(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_font_t* font,
+    uint8_t character
+);
+
+/**
+ * @brief Draws a null terminated string on a single line.
+ *
+ * @param canvas Pointer to the canvas.
+ * @param x Left column.
+ * @param y Top row.
+ * @param font Pointer to the font.
+ * @param str String to draw.
+ */
+void ssd1306_gfx_draw_str(
+    ssd1306_canvas_t* canvas,
+    int x,
+    int y,
+    const ssd1306_font_t* font,
+    const char* str
+);
+
+
+#endif //SSD1306_GFX_H
@@ -0,0 +1,142 @@
+#include <string.h>
+
+#include "ssd1306_gray.h"
+#include "ssd1306_gfx.h"
+
+
+static void ssd1306_gray_get_plane(
+    const ssd1306_gray_t* gray,
+    uint8_t plane_idx,
+    ssd1306_canvas_t* plane
+);
+
+
+void ssd1306_gray_get_plane(
+    const ssd1306_gray_t* gray,
+    uint8_t plane_idx,
+    ssd1306_canvas_t* plane
+)
+{
+    ssd1306_canvas_init(plane, gray->planes + plane_idx * SSD1306_RAM_BUFF_SIZE, SSD1306_WIDTH, SSD1306_HEIGHT);
+}
+
+ssd1306_err_t ssd1306_gray_init(
+    ssd1306_gray_t* gray,
+    uint8_t planes[],
+    uint8_t frame[]
+)
+{
+    if(gray == NULL || planes == NULL || frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    gray->planes = planes;
+    gray->frame = frame;
+    gray->subframe_idx = 0;
+
+    ssd1306_gray_clear(gray, 0);
+
+    return SSD1306_ERR_OK;
+}
+
+void ssd1306_gray_clear(
+    ssd1306_gray_t* gray,
+    uint8_t level
+)
+{
+    memset(gray->planes, level & 0x01 ? 0xFF : 0x00, SSD1306_RAM_BUFF_SIZE);
+    memset(gray->planes + SSD1306_RAM_BUFF_SIZE, level & 0x02 ? 0xFF : 0x00, SSD1306_RAM_BUFF_SIZE);
+}
+
+void ssd1306_gray_set_pixel(
+    ssd1306_gray_t* gray,
+    int x,
+    int y,
+    uint8_t level
+)
+{
+    ssd1306_canvas_t plane;
+
+    for(uint8_t i = 0; i < 2; ++i)
+    {
+        ssd1306_gray_get_plane(gray, i, &plane);
+        ssd1306_gfx_set_pixel(&plane, x, y, level & (1 << i));
+    }
+}
+
+uint8_t ssd1306_gray_get_pixel(
+    const ssd1306_gray_t* gray,
+    int x,
+    int y
+)
+{
+    ssd1306_canvas_t plane;
+    uint8_t level = 0;
+
+    for(uint8_t i = 0; i < 2; ++i)
+    {
+        ssd1306_gray_get_plane(gray, i, &plane);
+        level |= ssd1306_gfx_get_pixel(&plane, x, y) << i;
+    }
+
+    return level;
+}
+
+void ssd1306_gray_fill_rect(
+    ssd1306_gray_t* gray,
+    int x,
+    int y,
+    int w,
+    int h,
+    uint8_t level
+)
+{
+    ssd1306_canvas_t plane;
+
+    for(uint8_t i = 0; i < 2; ++i)
+    {
+        ssd1306_gray_get_plane(gray, i, &plane);
+        ssd1306_gfx_fill_rect(&plane, x, y, w, h, level & (1 << i));
+    }
+}
+
+ssd1306_err_t ssd1306_gray_flush_next(
+    ssd1306_gray_t* gray
+)
+{
+    if(gray == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    const uint8_t* lo = gray->planes;
+    const uint8_t* hi = gray->planes + SSD1306_RAM_BUFF_SIZE;
+    uint8_t* subframe = gray->frame + SSD1306_PREFIX_SIZE;
+
+    // Subframe k lights pixels of level > k
+    switch(gray->subframe_idx)
+    {
+        case 0:
+            for(size_t i = 0; i < SSD1306_RAM_BUFF_SIZE; ++i)
+            {
+                subframe[i] = lo[i] | hi[i];
+            }
+            break;
+
+        case 1:
+            memcpy(subframe, hi, SSD1306_RAM_BUFF_SIZE);
+            break;
+
+        default:
+            for(size_t i = 0; i < SSD1306_RAM_BUFF_SIZE; ++i)
+            {
+                subframe[i] = lo[i] & hi[i];
+            }
+            break;
+    }
+
+    gray->subframe_idx = (gray->subframe_idx + 1) % SSD1306_GRAY_SUBFRAME_COUNT;
+
+    return ssd1306_flush_prefixed(gray->frame);
+}
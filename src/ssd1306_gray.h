@@ -0,0 +1,136 @@
+/**
+ *
+ *  @file
+ *  @brief 4 level grayscale emulated by temporal dithering
+ *
+ **/
+
+#ifndef SSD1306_GRAY_H
+#define SSD1306_GRAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+
+/**
+ * @def SSD1306_GRAY_LEVEL_COUNT
+ * @brief Number of gray levels, 0 is off and SSD1306_GRAY_LEVEL_COUNT - 1 is fully on.
+ *
+ * @def SSD1306_GRAY_SUBFRAME_COUNT
+ * @brief Number of 1 bpp subframes making up one grayscale frame.
+ *
+ * @def SSD1306_GRAY_PLANES_SIZE
+ * @brief Size of the grayscale bitplanes in bytes.
+ */
+#define SSD1306_GRAY_LEVEL_COUNT            _u(4)
+#define SSD1306_GRAY_SUBFRAME_COUNT         (SSD1306_GRAY_LEVEL_COUNT - 1)
+#define SSD1306_GRAY_PLANES_SIZE            (2 * SSD1306_RAM_BUFF_SIZE)
+
+
+/**
+ * @struct ssd1306_gray_t
+ * @brief 2 bpp grayscale framebuffer shown as a sequence of 1 bpp subframes.
+ *
+ * Pixels are stored as two page-major bitplanes, the low bit plane followed by the high bit plane.
+ * Pixel of level L is on in L of SSD1306_GRAY_SUBFRAME_COUNT subframes, so the eye averages
+ * the subframes into gray as long as they are flushed at a steady rate.
+ */
+typedef struct ssd1306_gray_t
+{
+    uint8_t* planes;        /**< Bitplanes of SSD1306_GRAY_PLANES_SIZE bytes. */
+    uint8_t* frame;         /**< Prefixed frame of SSD1306_PREFIXED_FRAME_SIZE bytes subframes are composed in. */
+    uint8_t subframe_idx;   /**< Index of the next subframe to flush. */
+}
+ssd1306_gray_t;
+
+
+/**
+ * @brief Initializes a grayscale framebuffer over caller provided buffers. All pixels are set to level 0.
+ *
+ * @param gray Pointer to the framebuffer to initialize.
+ * @param planes Bitplanes of SSD1306_GRAY_PLANES_SIZE bytes.
+ * @param frame Prefixed frame of SSD1306_PREFIXED_FRAME_SIZE bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_gray_init(
+    ssd1306_gray_t* gray,
+    uint8_t planes[],
+    uint8_t frame[]
+);
+
+/**
+ * @brief Sets all pixels to the same level.
+ *
+ * @param gray Pointer to the framebuffer.
+ * @param level Gray level.
+ */
+void ssd1306_gray_clear(
+    ssd1306_gray_t* gray,
+    uint8_t level
+);
+
+/**
+ * @brief Sets a single pixel. Pixels outside the display are ignored.
+ *
+ * @param gray Pointer to the framebuffer.
+ * @param x Column.
+ * @param y Row.
+ * @param level Gray level.
+ */
+void ssd1306_gray_set_pixel(
+    ssd1306_gray_t* gray,
+    int x,
+    int y,
+    uint8_t level
+);
+
+/**
+ * @brief Gets a single pixel. Pixels outside the display read as level 0.
+ *
+ * @param gray Pointer to the framebuffer.
+ * @param x Column.
+ * @param y Row.
+ * @return Gray level.
+ */
+uint8_t ssd1306_gray_get_pixel(
+    const ssd1306_gray_t* gray,
+    int x,
+    int y
+);
+
+/**
+ * @brief Fills a rectangle, see ssd1306_gfx_fill_rect.
+ *
+ * @param gray Pointer to the framebuffer.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param level Gray level.
+ */
+void ssd1306_gray_fill_rect(
+    ssd1306_gray_t* gray,
+    int x,
+    int y,
+    int w,
+    int h,
+    uint8_t level
+);
+
+/**
+ * @brief Composes the next subframe and sends it with ssd1306_flush_prefixed.
+ * Only pages differing from the previous subframe are sent, so pages of levels 0 and 3 only cost their CRC.
+ * Call at a steady rate, e.g. from the main loop or a repeating timer, one grayscale frame
+ * takes SSD1306_GRAY_SUBFRAME_COUNT calls.
+ *
+ * @param gray Pointer to the framebuffer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_gray_flush_next(
+    ssd1306_gray_t* gray
+);
+
+
+#endif //SSD1306_GRAY_H
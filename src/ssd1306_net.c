@@ -0,0 +1,240 @@
+#include <string.h>
+#include <pico/stdlib.h>
+
+#include "ssd1306_net.h"
+
+
+static size_t ssd1306_net_write_u32(
+    uint8_t bytes[],
+    uint32_t value
+);
+static void ssd1306_net_send_nack(
+    ssd1306_net_server_t* server,
+    uint16_t expected_seq
+);
+
+
+size_t ssd1306_net_write_u32(
+    uint8_t bytes[],
+    uint32_t value
+)
+{
+    bytes[0] = value & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = value >> 24;
+
+    return 4;
+}
+
+void ssd1306_net_send_nack(
+    ssd1306_net_server_t* server,
+    uint16_t expected_seq
+)
+{
+    if(server->reply == NULL)
+    {
+        return;
+    }
+
+    uint8_t nack[SSD1306_NET_HEADER_SIZE];
+
+    ssd1306_net_write_header(nack, SSD1306_NET_FLAG_NACK, expected_seq, 0);
+    server->reply(server->reply_user_data, nack, sizeof(nack));
+}
+
+ssd1306_err_t ssd1306_net_server_init(
+    ssd1306_net_server_t* server,
+    uint8_t frame[],
+    ssd1306_net_reply_t reply,
+    void* reply_user_data
+)
+{
+    if(server == NULL || frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    memset(server, 0, sizeof(ssd1306_net_server_t));
+    ssd1306_net_decoder_init(&server->decoder, frame);
+    server->reply = reply;
+    server->reply_user_data = reply_user_data;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_net_server_receive(
+    ssd1306_net_server_t* server,
+    const uint8_t packet[],
+    size_t packet_len
+)
+{
+    if(server == NULL || packet == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    ssd1306_net_header_t header;
+    uint16_t expected_seq = server->decoder.last_seq + 1;
+    ssd1306_net_verdict_t verdict = ssd1306_net_decode(&server->decoder, packet, packet_len, &header);
+
+    if(verdict == SSD1306_NET_VERDICT_MALFORMED)
+    {
+        return SSD1306_ERR_INVALID_NET_PACKET;
+    }
+    if(verdict == SSD1306_NET_VERDICT_STALE)
+    {
+        return SSD1306_ERR_OK;
+    }
+    if(verdict == SSD1306_NET_VERDICT_STATS)
+    {
+        uint8_t reply[SSD1306_NET_STATS_MAX_SIZE];
+        size_t reply_len = 0;
+
+        if(server->reply == NULL)
+        {
+            return SSD1306_ERR_OK;
+        }
+
+        ssd1306_err_t error = ssd1306_net_build_stats(server, header.seq, reply, sizeof(reply), &reply_len);
+
+        if(error != SSD1306_ERR_OK)
+        {
+            return error;
+        }
+
+        return server->reply(server->reply_user_data, reply, reply_len);
+    }
+    if(verdict == SSD1306_NET_VERDICT_GAP)
+    {
+        ssd1306_net_send_nack(server, expected_seq);
+    }
+
+    if(header.flags & SSD1306_NET_FLAG_FLUSH)
+    {
+        return ssd1306_net_server_flush(server);
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_net_server_flush(
+    ssd1306_net_server_t* server
+)
+{
+    if(server == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    uint8_t window_page_start;
+    uint8_t window_page_count;
+    ssd1306_err_t error = ssd1306_get_row_window(&window_page_start, &window_page_count);
+
+    // Damage outside of the row window is not scanned by the panel and is dropped
+    uint8_t window_page_end = window_page_start + window_page_count;
+    uint8_t page = window_page_start;
+
+    while(page < window_page_end && error == SSD1306_ERR_OK)
+    {
+        if(!(server->decoder.damage_page_mask & (1 << page)))
+        {
+            ++page;
+            continue;
+        }
+
+        uint8_t page_start = page;
+        uint8_t col_start = server->decoder.damage_col_start[page];
+        uint8_t col_end = server->decoder.damage_col_end[page];
+
+        while(page + 1 < window_page_end && (server->decoder.damage_page_mask & (1 << (page + 1))))
+        {
+            ++page;
+            col_start = server->decoder.damage_col_start[page] < col_start ? server->decoder.damage_col_start[page] : col_start;
+            col_end = server->decoder.damage_col_end[page] > col_end ? server->decoder.damage_col_end[page] : col_end;
+        }
+
+        error = ssd1306_flush_area(server->decoder.frame + window_page_start * SSD1306_WIDTH, page_start, page, col_start, col_end);
+        ++page;
+    }
+
+    if(error == SSD1306_ERR_OK)
+    {
+        server->decoder.damage_page_mask = 0;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_net_build_stats(
+    const ssd1306_net_server_t* server,
+    uint16_t seq,
+    uint8_t buffer[],
+    size_t buffer_cap,
+    size_t* buffer_len
+)
+{
+    if(server == NULL || buffer == NULL || buffer_len == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    ssd1306_stats_t stats;
+    ssd1306_get_stats(&stats);
+
+    uint8_t error_code_count = 0;
+
+    for(uint i = 0; i < SSD1306_ERR_COUNT; ++i)
+    {
+        error_code_count += stats.errors_by_code[i] != 0;
+    }
+
+    size_t len = SSD1306_NET_HEADER_SIZE + 17 * 4 + 1 + 5 * error_code_count;
+
+    if(buffer_cap < len)
+    {
+        return SSD1306_ERR_INVALID_BUFF_SIZE;
+    }
+
+    const uint32_t fields[] = {
+        to_ms_since_boot(get_absolute_time()),
+        stats.transactions,
+        stats.cmd_transactions,
+        stats.data_transactions,
+        stats.bytes,
+        stats.errors,
+        (uint32_t)(stats.wire_time_ns / 1000),
+        (uint32_t)stats.bus_time_us,
+        stats.flushes,
+        ssd1306_time_hist_percentile_us(stats.flush_latency_hist, 50),
+        ssd1306_time_hist_percentile_us(stats.flush_latency_hist, 90),
+        ssd1306_time_hist_percentile_us(stats.flush_latency_hist, 99),
+        server->decoder.stats.packets,
+        server->decoder.stats.applied,
+        server->decoder.stats.dropped_stale,
+        server->decoder.stats.dropped_malformed,
+        server->decoder.stats.lost,
+    };
+
+    size_t pos = ssd1306_net_write_header(buffer, SSD1306_NET_FLAG_STATS, seq, 0);
+
+    for(size_t i = 0; i < count_of(fields); ++i)
+    {
+        pos += ssd1306_net_write_u32(buffer + pos, fields[i]);
+    }
+
+    buffer[pos++] = error_code_count;
+
+    for(uint i = 0; i < SSD1306_ERR_COUNT; ++i)
+    {
+        if(stats.errors_by_code[i] != 0)
+        {
+            buffer[pos++] = i;
+            pos += ssd1306_net_write_u32(buffer + pos, stats.errors_by_code[i]);
+        }
+    }
+
+    *buffer_len = pos;
+
+    return SSD1306_ERR_OK;
+}
@@ -0,0 +1,146 @@
+/**
+ *
+ *  @file
+ *  @brief UDP display server applying remote dirty-region updates
+ *
+ **/
+
+#ifndef SSD1306_NET_H
+#define SSD1306_NET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_net_proto.h"
+
+/**
+ * @def SSD1306_NET_STATS_MAX_SIZE
+ * @brief Maximum size of a telemetry reply in bytes, every error code reported.
+ */
+#define SSD1306_NET_STATS_MAX_SIZE          (SSD1306_NET_HEADER_SIZE + 17 * 4 + 1 + 5 * SSD1306_ERR_COUNT)
+
+
+/**
+ * @brief Reply function of the display server, e.g. a UDP send to the packet source.
+ *
+ * @param user_data User data pointer passed to ssd1306_net_server_init.
+ * @param buffer Reply packet.
+ * @param buffer_len Size of the reply packet in bytes.
+ * @return API error code.
+ */
+typedef ssd1306_err_t (*ssd1306_net_reply_t)(
+    void* user_data,
+    const uint8_t buffer[],
+    size_t buffer_len
+);
+
+/**
+ * @struct ssd1306_net_server_t
+ * @brief Display server state: protocol decoder, reply path and network stack binding.
+ * Packet layout and sequencing are described with ssd1306_net_decoder_t.
+ *
+ * Telemetry follows the header, all numbers uint32 unless stated otherwise:
+ * uptime in ms, transactions, command transactions, RAM data transactions, bytes, failed transactions,
+ * modeled wire time in us, measured bus time in us, flushes, flush latency 50th, 90th and 99th percentiles in us,
+ * received, applied, stale, malformed and lost packets,
+ * uint8 number of reported error codes followed by uint8 code and uint32 count of every code that occurred.
+ */
+typedef struct ssd1306_net_server_t
+{
+    ssd1306_net_decoder_t decoder;                      /**< Frame, sequencing, updated regions and packet counters. */
+    ssd1306_net_reply_t reply;                          /**< Reply function, may be NULL. */
+    void* reply_user_data;                              /**< User data pointer passed to reply. */
+    void* udp_pcb;                                      /**< lwIP UDP PCB while the server is started. */
+}
+ssd1306_net_server_t;
+
+
+/**
+ * @brief Initializes a display server over a caller provided frame.
+ *
+ * @param server Pointer to the server.
+ * @param frame Page-major frame of SSD1306_RAM_BUFF_SIZE bytes.
+ * @param reply Reply function or NULL.
+ * @param reply_user_data User data pointer passed to reply.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_server_init(
+    ssd1306_net_server_t* server,
+    uint8_t frame[],
+    ssd1306_net_reply_t reply,
+    void* reply_user_data
+);
+
+/**
+ * @brief Decodes a packet with ssd1306_net_decode, then sends the NACK, telemetry or flush it calls for.
+ * Independent of the network stack, so any datagram source can feed it.
+ *
+ * @param server Pointer to the server.
+ * @param packet Packet bytes.
+ * @param packet_len Size of the packet in bytes.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_server_receive(
+    ssd1306_net_server_t* server,
+    const uint8_t packet[],
+    size_t packet_len
+);
+
+/**
+ * @brief Sends regions applied since the last flush to the display.
+ * Consecutive updated pages share one address window spanning all their columns.
+ *
+ * @param server Pointer to the server.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_server_flush(
+    ssd1306_net_server_t* server
+);
+
+/**
+ * @brief Builds a telemetry packet from the driver counters and the server packet counters.
+ * Sent by the server in reply to SSD1306_NET_FLAG_STATS requests.
+ *
+ * @param server Pointer to the server.
+ * @param seq Sequence number of the packet.
+ * @param buffer Buffer to store the packet, SSD1306_NET_STATS_MAX_SIZE bytes are always enough.
+ * @param buffer_cap Size of the buffer.
+ * @param buffer_len Pointer to store the packet size.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_build_stats(
+    const ssd1306_net_server_t* server,
+    uint16_t seq,
+    uint8_t buffer[],
+    size_t buffer_cap,
+    size_t* buffer_len
+);
+
+/**
+ * @brief Starts receiving packets on a UDP port of the default lwIP network interface.
+ * NACKs are sent back to the packet source. Packets are handled in the lwIP receive callback,
+ * so with pico_cyw43_arch_lwip_poll they hit the bus from cyw43_arch_poll.
+ *
+ * @param server Pointer to the initialized server.
+ * @param port UDP port.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_server_start(
+    ssd1306_net_server_t* server,
+    uint16_t port
+);
+
+/**
+ * @brief Stops receiving packets.
+ *
+ * @param server Pointer to the started server.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_net_server_stop(
+    ssd1306_net_server_t* server
+);
+
+
+#endif //SSD1306_NET_H
@@ -0,0 +1,143 @@
+#include <string.h>
+#include <lwip/udp.h>
+#include <lwip/pbuf.h>
+
+#include "ssd1306_net.h"
+
+
+typedef struct ssd1306_net_lwip_peer_t
+{
+    ip_addr_t addr;
+    u16_t port;
+}
+ssd1306_net_lwip_peer_t;
+
+
+static void ssd1306_net_lwip_recv(
+    void* arg,
+    struct udp_pcb* pcb,
+    struct pbuf* p,
+    const ip_addr_t* addr,
+    u16_t port
+);
+static ssd1306_err_t ssd1306_net_lwip_reply(
+    void* user_data,
+    const uint8_t buffer[],
+    size_t buffer_len
+);
+
+
+static ssd1306_net_lwip_peer_t ssd1306_net_lwip_peer = {};
+
+void ssd1306_net_lwip_recv(
+    void* arg,
+    struct udp_pcb* pcb,
+    struct pbuf* p,
+    const ip_addr_t* addr,
+    u16_t port
+)
+{
+    ssd1306_net_server_t* server = (ssd1306_net_server_t*)arg;
+
+    ip_addr_copy(ssd1306_net_lwip_peer.addr, *addr);
+    ssd1306_net_lwip_peer.port = port;
+
+    // Packets held by a single pbuf are parsed in place, chained ones need a copy
+    if(p->next == NULL)
+    {
+        ssd1306_net_server_receive(server, (const uint8_t*)p->payload, p->len);
+    }
+    else
+    if(p->tot_len <= SSD1306_NET_MAX_PACKET_SIZE)
+    {
+        static uint8_t packet[SSD1306_NET_MAX_PACKET_SIZE];
+        u16_t packet_len = pbuf_copy_partial(p, packet, sizeof(packet), 0);
+
+        ssd1306_net_server_receive(server, packet, packet_len);
+    }
+    else
+    {
+        ++server->decoder.stats.packets;
+        ++server->decoder.stats.dropped_malformed;
+    }
+
+    pbuf_free(p);
+}
+
+ssd1306_err_t ssd1306_net_lwip_reply(
+    void* user_data,
+    const uint8_t buffer[],
+    size_t buffer_len
+)
+{
+    ssd1306_net_server_t* server = (ssd1306_net_server_t*)user_data;
+    struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, buffer_len, PBUF_RAM);
+
+    if(p == NULL)
+    {
+        return SSD1306_ERR_NET_ERROR;
+    }
+
+    memcpy(p->payload, buffer, buffer_len);
+
+    err_t err = udp_sendto((struct udp_pcb*)server->udp_pcb, p, &ssd1306_net_lwip_peer.addr, ssd1306_net_lwip_peer.port);
+    pbuf_free(p);
+
+    return err == ERR_OK ? SSD1306_ERR_OK : SSD1306_ERR_NET_ERROR;
+}
+
+ssd1306_err_t ssd1306_net_server_start(
+    ssd1306_net_server_t* server,
+    uint16_t port
+)
+{
+    if(server == NULL || server->decoder.frame == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(server->udp_pcb != NULL)
+    {
+        return SSD1306_ERR_INITIALIZED;
+    }
+
+    struct udp_pcb* pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+
+    if(pcb == NULL)
+    {
+        return SSD1306_ERR_NET_ERROR;
+    }
+    if(udp_bind(pcb, IP_ANY_TYPE, port) != ERR_OK)
+    {
+        udp_remove(pcb);
+        return SSD1306_ERR_NET_ERROR;
+    }
+
+    server->udp_pcb = pcb;
+    server->reply = ssd1306_net_lwip_reply;
+    server->reply_user_data = server;
+
+    udp_recv(pcb, ssd1306_net_lwip_recv, server);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_net_server_stop(
+    ssd1306_net_server_t* server
+)
+{
+    if(server == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(server->udp_pcb == NULL)
+    {
+        return SSD1306_ERR_DEINITIALIZED;
+    }
+
+    udp_remove((struct udp_pcb*)server->udp_pcb);
+    server->udp_pcb = NULL;
+    server->reply = NULL;
+    server->reply_user_data = NULL;
+
+    return SSD1306_ERR_OK;
+}
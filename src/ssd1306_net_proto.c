@@ -0,0 +1,311 @@
+#include <string.h>
+
+#include "ssd1306_net_proto.h"
+
+
+static uint16_t ssd1306_net_read_u16(
+    const uint8_t bytes[]
+);
+static void ssd1306_net_add_damage(
+    ssd1306_net_decoder_t* decoder,
+    uint8_t page,
+    uint8_t col_start,
+    uint8_t col_end
+);
+
+
+uint16_t ssd1306_net_read_u16(
+    const uint8_t bytes[]
+)
+{
+    return (uint16_t)bytes[0] | (uint16_t)bytes[1] << 8;
+}
+
+void ssd1306_net_add_damage(
+    ssd1306_net_decoder_t* decoder,
+    uint8_t page,
+    uint8_t col_start,
+    uint8_t col_end
+)
+{
+    if(!(decoder->damage_page_mask & (1 << page)))
+    {
+        decoder->damage_page_mask |= 1 << page;
+        decoder->damage_col_start[page] = col_start;
+        decoder->damage_col_end[page] = col_end;
+        return;
+    }
+
+    if(col_start < decoder->damage_col_start[page])
+    {
+        decoder->damage_col_start[page] = col_start;
+    }
+    if(col_end > decoder->damage_col_end[page])
+    {
+        decoder->damage_col_end[page] = col_end;
+    }
+}
+
+void ssd1306_net_decoder_init(
+    ssd1306_net_decoder_t* decoder,
+    uint8_t frame[]
+)
+{
+    memset(decoder, 0, sizeof(ssd1306_net_decoder_t));
+    decoder->frame = frame;
+}
+
+bool ssd1306_net_validate(
+    const uint8_t packet[],
+    size_t packet_len
+)
+{
+    if(packet_len < SSD1306_NET_HEADER_SIZE
+    || memcmp(packet, SSD1306_NET_MAGIC, 2) != 0
+    || packet[2] != SSD1306_NET_VERSION
+    || (packet[3] & SSD1306_NET_FLAG_NACK))
+    {
+        return false;
+    }
+
+    uint8_t region_count = packet[6];
+    size_t pos = SSD1306_NET_HEADER_SIZE;
+
+    for(uint8_t i = 0; i < region_count; ++i)
+    {
+        if(pos + SSD1306_NET_REGION_HEADER_SIZE > packet_len)
+        {
+            return false;
+        }
+
+        uint8_t page = packet[pos];
+        uint8_t col_start = packet[pos + 1];
+        uint8_t col_end = packet[pos + 2];
+        size_t payload_len = ssd1306_net_read_u16(packet + pos + 3);
+
+        pos += SSD1306_NET_REGION_HEADER_SIZE;
+
+        if(page >= SSD1306_PAGE_COUNT
+        || col_start > col_end || col_end >= SSD1306_WIDTH
+        || pos + payload_len > packet_len
+        || !ssd1306_net_rle_decode(packet + pos, payload_len, NULL, col_end - col_start + 1))
+        {
+            return false;
+        }
+
+        pos += payload_len;
+    }
+
+    return pos == packet_len;
+}
+
+ssd1306_net_verdict_t ssd1306_net_decode(
+    ssd1306_net_decoder_t* decoder,
+    const uint8_t packet[],
+    size_t packet_len,
+    ssd1306_net_header_t* header
+)
+{
+    ++decoder->stats.packets;
+
+    // Whole packet is checked first, so a malformed one never leaves a half applied frame
+    if(!ssd1306_net_validate(packet, packet_len))
+    {
+        ++decoder->stats.dropped_malformed;
+        return SSD1306_NET_VERDICT_MALFORMED;
+    }
+
+    header->flags = packet[3];
+    header->seq = ssd1306_net_read_u16(packet + 4);
+    header->region_count = packet[6];
+
+    // Telemetry requests don't take part in frame sequencing
+    if(header->flags & SSD1306_NET_FLAG_STATS)
+    {
+        return SSD1306_NET_VERDICT_STATS;
+    }
+
+    ssd1306_net_verdict_t verdict = SSD1306_NET_VERDICT_APPLIED;
+
+    if(decoder->is_seq_valid && !(header->flags & SSD1306_NET_FLAG_KEYFRAME))
+    {
+        uint16_t expected_seq = decoder->last_seq + 1;
+        int16_t seq_diff = (int16_t)(header->seq - expected_seq);
+
+        if(seq_diff < 0)
+        {
+            ++decoder->stats.dropped_stale;
+            return SSD1306_NET_VERDICT_STALE;
+        }
+        if(seq_diff > 0)
+        {
+            decoder->stats.lost += seq_diff;
+            verdict = SSD1306_NET_VERDICT_GAP;
+        }
+    }
+
+    decoder->last_seq = header->seq;
+    decoder->is_seq_valid = true;
+
+    size_t pos = SSD1306_NET_HEADER_SIZE;
+
+    for(uint8_t i = 0; i < header->region_count; ++i)
+    {
+        uint8_t page = packet[pos];
+        uint8_t col_start = packet[pos + 1];
+        uint8_t col_end = packet[pos + 2];
+        size_t payload_len = ssd1306_net_read_u16(packet + pos + 3);
+
+        pos += SSD1306_NET_REGION_HEADER_SIZE;
+
+        ssd1306_net_rle_decode(
+            packet + pos, payload_len,
+            decoder->frame + page * SSD1306_WIDTH + col_start,
+            col_end - col_start + 1
+        );
+        ssd1306_net_add_damage(decoder, page, col_start, col_end);
+
+        pos += payload_len;
+    }
+
+    ++decoder->stats.applied;
+
+    return verdict;
+}
+
+size_t ssd1306_net_write_header(
+    uint8_t buffer[],
+    uint8_t flags,
+    uint16_t seq,
+    uint8_t region_count
+)
+{
+    buffer[0] = SSD1306_NET_MAGIC[0];
+    buffer[1] = SSD1306_NET_MAGIC[1];
+    buffer[2] = SSD1306_NET_VERSION;
+    buffer[3] = flags;
+    buffer[4] = seq & 0xFF;
+    buffer[5] = seq >> 8;
+    buffer[6] = region_count;
+    buffer[7] = 0;
+
+    return SSD1306_NET_HEADER_SIZE;
+}
+
+bool ssd1306_net_rle_decode(
+    const uint8_t src[],
+    size_t src_len,
+    uint8_t dst[],
+    size_t dst_len
+)
+{
+    // Validates only when dst is NULL
+    size_t src_pos = 0;
+    size_t dst_pos = 0;
+
+    while(src_pos < src_len)
+    {
+        uint8_t ctrl = src[src_pos++];
+        size_t count = (ctrl & 0x7F) + 1;
+
+        if(dst_pos + count > dst_len)
+        {
+            return false;
+        }
+
+        if(ctrl & 0x80)
+        {
+            if(src_pos + 1 > src_len)
+            {
+                return false;
+            }
+            if(dst != NULL)
+            {
+                memset(dst + dst_pos, src[src_pos], count);
+            }
+
+            src_pos += 1;
+        }
+        else
+        {
+            if(src_pos + count > src_len)
+            {
+                return false;
+            }
+            if(dst != NULL)
+            {
+                memcpy(dst + dst_pos, src + src_pos, count);
+            }
+
+            src_pos += count;
+        }
+
+        dst_pos += count;
+    }
+
+    return dst_pos == dst_len;
+}
+
+bool ssd1306_net_rle_encode(
+    const uint8_t src[],
+    size_t src_len,
+    uint8_t dst[],
+    size_t dst_cap,
+    size_t* dst_len
+)
+{
+    size_t src_pos = 0;
+    size_t dst_pos = 0;
+
+    while(src_pos < src_len)
+    {
+        size_t run = 1;
+
+        while(src_pos + run < src_len && run < 128 && src[src_pos + run] == src[src_pos])
+        {
+            ++run;
+        }
+
+        // Runs shorter than 3 bytes are cheaper as literals
+        if(run >= 3)
+        {
+            if(dst_pos + 2 > dst_cap)
+            {
+                return false;
+            }
+
+            dst[dst_pos++] = 0x80 | (run - 1);
+            dst[dst_pos++] = src[src_pos];
+            src_pos += run;
+            continue;
+        }
+
+        size_t literal = 0;
+
+        while(src_pos + literal < src_len && literal < 128)
+        {
+            size_t pos = src_pos + literal;
+
+            if(pos + 2 < src_len && src[pos] == src[pos + 1] && src[pos] == src[pos + 2])
+            {
+                break;
+            }
+
+            ++literal;
+        }
+
+        if(dst_pos + 1 + literal > dst_cap)
+        {
+            return false;
+        }
+
+        dst[dst_pos++] = literal - 1;
+        memcpy(dst + dst_pos, src + src_pos, literal);
+        dst_pos += literal;
+        src_pos += literal;
+    }
+
+    *dst_len = dst_pos;
+
+    return true;
+}
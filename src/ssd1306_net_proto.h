@@ -0,0 +1,216 @@
+/**
+ *
+ *  @file
+ *  @brief Display protocol core: packet validation, RLE and sequencing
+ *
+ *  Has no Pico SDK or network stack dependency, so controllers and host tests share it with the server.
+ *
+ **/
+
+#ifndef SSD1306_NET_PROTO_H
+#define SSD1306_NET_PROTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_spec.h"
+
+/**
+ * @def SSD1306_NET_DEFAULT_PORT
+ * @brief Default UDP port of the display server.
+ *
+ * @def SSD1306_NET_MAGIC
+ * @brief First 2 bytes of every packet.
+ *
+ * @def SSD1306_NET_VERSION
+ * @brief Protocol version carried by every packet.
+ *
+ * @def SSD1306_NET_HEADER_SIZE
+ * @brief Size of the packet header in bytes.
+ *
+ * @def SSD1306_NET_REGION_HEADER_SIZE
+ * @brief Size of the region header in bytes.
+ *
+ * @def SSD1306_NET_MAX_PACKET_SIZE
+ * @brief Maximum packet size in bytes, UDP payload of an unfragmented Ethernet frame.
+ */
+#define SSD1306_NET_DEFAULT_PORT            4210u
+#define SSD1306_NET_MAGIC                   "SD"
+#define SSD1306_NET_VERSION                 1u
+#define SSD1306_NET_HEADER_SIZE             8u
+#define SSD1306_NET_REGION_HEADER_SIZE      5u
+#define SSD1306_NET_MAX_PACKET_SIZE         1472u
+
+
+/**
+ * @enum ssd1306_net_flag_t
+ * @brief Packet header flags.
+ */
+typedef enum ssd1306_net_flag_t
+{
+    SSD1306_NET_FLAG_FLUSH      = 0x01u,    /**< Send all regions received so far to the display after applying the packet. */
+    SSD1306_NET_FLAG_KEYFRAME   = 0x02u,    /**< Accept the packet whatever its sequence number, e.g. after a controller restart. */
+    SSD1306_NET_FLAG_STATS      = 0x40u,    /**< Telemetry request, regions are ignored. Answered with telemetry carrying the same flag and sequence number. */
+    SSD1306_NET_FLAG_NACK       = 0x80u,    /**< Reply from the server, sequence number is the first one missing. */
+} ssd1306_net_flag_t;
+
+/**
+ * @enum ssd1306_net_verdict_t
+ * @brief Outcome of decoding a packet.
+ */
+typedef enum ssd1306_net_verdict_t
+{
+    SSD1306_NET_VERDICT_APPLIED,    /**< Regions are applied to the frame. */
+    SSD1306_NET_VERDICT_GAP,        /**< Regions are applied to the frame, packets in front of it were lost. */
+    SSD1306_NET_VERDICT_STALE,      /**< Duplicate or late packet is dropped. */
+    SSD1306_NET_VERDICT_MALFORMED,  /**< Malformed packet is dropped as a whole. */
+    SSD1306_NET_VERDICT_STATS,      /**< Telemetry request, nothing is applied. */
+} ssd1306_net_verdict_t;
+
+/**
+ * @struct ssd1306_net_header_t
+ * @brief Decoded packet header.
+ */
+typedef struct ssd1306_net_header_t
+{
+    uint8_t flags;          /**< Packet flags, see ssd1306_net_flag_t. */
+    uint16_t seq;           /**< Sequence number. */
+    uint8_t region_count;   /**< Number of regions following the header. */
+}
+ssd1306_net_header_t;
+
+/**
+ * @struct ssd1306_net_stats_t
+ * @brief Display server packet counters.
+ */
+typedef struct ssd1306_net_stats_t
+{
+    uint32_t packets;               /**< Number of received packets. */
+    uint32_t applied;               /**< Number of packets applied to the frame. */
+    uint32_t dropped_stale;         /**< Number of duplicate or late packets dropped. */
+    uint32_t dropped_malformed;     /**< Number of malformed packets dropped. */
+    uint32_t lost;                  /**< Number of packets skipped by sequence number. */
+}
+ssd1306_net_stats_t;
+
+/**
+ * @struct ssd1306_net_decoder_t
+ * @brief Receiving side of the protocol: frame, sequencing and regions updated since the last flush.
+ *
+ * Packet layout, all numbers little-endian:
+ * - header: SSD1306_NET_MAGIC, uint8 version, uint8 flags, uint16 sequence number, uint8 region count, uint8 reserved (0);
+ * - regions: uint8 page, uint8 first column, uint8 last column, uint16 payload size, RLE payload.
+ *
+ * RLE payload decodes to exactly one byte per column of the region.
+ * Control byte c < 0x80 is followed by c + 1 literal bytes, c >= 0x80 by one byte repeated c - 0x80 + 1 times.
+ *
+ * Regions carry absolute RAM contents, so a lost packet only leaves its regions stale until they are sent again.
+ * Packets older than the last applied one are dropped, a gap is reported to the sender with a NACK.
+ */
+typedef struct ssd1306_net_decoder_t
+{
+    uint8_t* frame;                                     /**< Page-major frame of SSD1306_RAM_BUFF_SIZE bytes. */
+    uint16_t last_seq;                                  /**< Sequence number of the last applied packet. */
+    bool is_seq_valid;                                  /**< Whether any packet was applied yet. */
+    uint8_t damage_col_start[SSD1306_PAGE_COUNT];       /**< First updated column of every page. */
+    uint8_t damage_col_end[SSD1306_PAGE_COUNT];         /**< Last updated column of every page. */
+    uint8_t damage_page_mask;                           /**< Pages updated since the last flush. */
+    ssd1306_net_stats_t stats;                          /**< Packet counters. */
+}
+ssd1306_net_decoder_t;
+
+
+/**
+ * @brief Initializes a decoder over a caller provided frame.
+ *
+ * @param decoder Pointer to the decoder.
+ * @param frame Page-major frame of SSD1306_RAM_BUFF_SIZE bytes.
+ */
+void ssd1306_net_decoder_init(
+    ssd1306_net_decoder_t* decoder,
+    uint8_t frame[]
+);
+
+/**
+ * @brief Checks the header, every region bounds and every RLE payload of a packet.
+ *
+ * @param packet Packet bytes.
+ * @param packet_len Size of the packet in bytes.
+ * @return True if the packet is well formed.
+ */
+bool ssd1306_net_validate(
+    const uint8_t packet[],
+    size_t packet_len
+);
+
+/**
+ * @brief Validates a packet, checks its sequence number and applies its regions to the frame.
+ * Malformed packets are dropped as a whole. Packet counters are updated.
+ *
+ * @param decoder Pointer to the decoder.
+ * @param packet Packet bytes.
+ * @param packet_len Size of the packet in bytes.
+ * @param header Pointer to store the packet header, left untouched for malformed packets.
+ * @return Outcome of decoding. After SSD1306_NET_VERDICT_GAP the first missing sequence number
+ * is the last applied one before the call plus one.
+ */
+ssd1306_net_verdict_t ssd1306_net_decode(
+    ssd1306_net_decoder_t* decoder,
+    const uint8_t packet[],
+    size_t packet_len,
+    ssd1306_net_header_t* header
+);
+
+/**
+ * @brief Writes a packet header, e.g. of a NACK or a telemetry reply.
+ *
+ * @param buffer Buffer of SSD1306_NET_HEADER_SIZE bytes.
+ * @param flags Packet flags.
+ * @param seq Sequence number.
+ * @param region_count Number of regions following the header.
+ * @return Number of written bytes.
+ */
+size_t ssd1306_net_write_header(
+    uint8_t buffer[],
+    uint8_t flags,
+    uint16_t seq,
+    uint8_t region_count
+);
+
+/**
+ * @brief Decodes a region payload.
+ *
+ * @param src Encoded bytes.
+ * @param src_len Number of encoded bytes.
+ * @param dst Buffer to store the decoded bytes, NULL to validate only.
+ * @param dst_len Exact number of decoded bytes.
+ * @return False if the payload is truncated or doesn't decode to exactly dst_len bytes.
+ */
+bool ssd1306_net_rle_decode(
+    const uint8_t src[],
+    size_t src_len,
+    uint8_t dst[],
+    size_t dst_len
+);
+
+/**
+ * @brief Encodes bytes with the RLE scheme of region payloads, e.g. on a controller.
+ *
+ * @param src Bytes to encode.
+ * @param src_len Number of bytes to encode.
+ * @param dst Buffer to store the encoded bytes.
+ * @param dst_cap Size of the buffer, src_len + src_len / 128 + 1 bytes are always enough.
+ * @param dst_len Pointer to store the number of encoded bytes.
+ * @return False if the buffer is too small.
+ */
+bool ssd1306_net_rle_encode(
+    const uint8_t src[],
+    size_t src_len,
+    uint8_t dst[],
+    size_t dst_cap,
+    size_t* dst_len
+);
+
+
+#endif //SSD1306_NET_PROTO_H
@@ -0,0 +1,149 @@
+#include <string.h>
+#include <pico/stdlib.h>
+
+#include "ssd1306_recorder.h"
+
+
+static size_t ssd1306_recorder_put_varint(
+    uint8_t buffer[],
+    uint64_t value
+);
+
+
+size_t ssd1306_recorder_put_varint(
+    uint8_t buffer[],
+    uint64_t value
+)
+{
+    size_t len = 0;
+
+    do
+    {
+        buffer[len++] = (value & 0x7F) | (value > 0x7F ? 0x80 : 0x00);
+        value >>= 7;
+    }
+    while(value != 0);
+
+    return len;
+}
+
+ssd1306_err_t ssd1306_recorder_init(
+    ssd1306_recorder_t* recorder,
+    uint8_t buffer[],
+    size_t size,
+    ssd1306_transport_writev_t writev,
+    void* user_data
+)
+{
+    if(recorder == NULL || buffer == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(size < SSD1306_REPLAY_HEADER_SIZE)
+    {
+        return SSD1306_ERR_INVALID_BUFF_SIZE;
+    }
+
+    recorder->buffer = buffer;
+    recorder->size = size;
+    recorder->writev = writev;
+    recorder->user_data = user_data;
+
+    ssd1306_recorder_reset(recorder);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_recorder_writev(
+    void* user_data,
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+)
+{
+    ssd1306_recorder_t* recorder = (ssd1306_recorder_t*)user_data;
+    uint64_t now_us = time_us_64();
+    size_t buffer_len = 0;
+
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+        buffer_len += segments[i].len;
+    }
+
+    if(recorder->dropped == 0 && buffer_len > 0
+    && recorder->size - recorder->used >= SSD1306_REPLAY_MAX_RECORD_HEAD_SIZE + buffer_len - 1)
+    {
+        uint8_t* record = recorder->buffer + recorder->used;
+        uint8_t* payload = record + 1;
+        bool is_type = true;
+
+        payload += ssd1306_recorder_put_varint(payload, now_us - recorder->last_us);
+        payload += ssd1306_recorder_put_varint(payload, buffer_len - 1);
+
+        // The control byte is the record type, the rest is the payload
+        for(size_t i = 0; i < segment_count; ++i)
+        {
+            const uint8_t* data = segments[i].data;
+            size_t len = segments[i].len;
+
+            if(is_type && len > 0)
+            {
+                record[0] = *data++;
+                --len;
+                is_type = false;
+            }
+
+            memcpy(payload, data, len);
+            payload += len;
+        }
+
+        recorder->used = payload - recorder->buffer;
+        recorder->last_us = now_us;
+    }
+    else if(buffer_len > 0)
+    {
+        ++recorder->dropped;
+    }
+
+    if(recorder->writev == NULL)
+    {
+        return SSD1306_ERR_OK;
+    }
+
+    return recorder->writev(recorder->user_data, segments, segment_count);
+}
+
+void ssd1306_recorder_mark_frame(
+    void* user_data
+)
+{
+    ssd1306_recorder_t* recorder = (ssd1306_recorder_t*)user_data;
+    uint64_t now_us = time_us_64();
+
+    if(recorder->dropped != 0 || recorder->size - recorder->used < SSD1306_REPLAY_MAX_RECORD_HEAD_SIZE)
+    {
+        ++recorder->dropped;
+        return;
+    }
+
+    uint8_t* record = recorder->buffer + recorder->used;
+    uint8_t* payload = record + 1;
+
+    record[0] = SSD1306_REPLAY_TYPE_FRAME;
+    payload += ssd1306_recorder_put_varint(payload, now_us - recorder->last_us);
+    payload += ssd1306_recorder_put_varint(payload, 0);
+
+    recorder->used = payload - recorder->buffer;
+    recorder->last_us = now_us;
+}
+
+void ssd1306_recorder_reset(
+    ssd1306_recorder_t* recorder
+)
+{
+    memcpy(recorder->buffer, SSD1306_REPLAY_MAGIC, SSD1306_REPLAY_MAGIC_SIZE);
+    recorder->buffer[SSD1306_REPLAY_MAGIC_SIZE] = SSD1306_REPLAY_VERSION;
+
+    recorder->used = SSD1306_REPLAY_HEADER_SIZE;
+    recorder->last_us = time_us_64();
+    recorder->dropped = 0;
+}
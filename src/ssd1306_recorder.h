@@ -0,0 +1,92 @@
+/**
+ *
+ *  @file
+ *  @brief Recording transport logging every transaction in the ssd1306_replay log format
+ *
+ **/
+
+#ifndef SSD1306_RECORDER_H
+#define SSD1306_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_replay.h"
+
+
+/**
+ * @struct ssd1306_recorder_t
+ * @brief Log of transactions in a caller provided buffer, optionally forwarded to another transport.
+ * The log is the first used bytes of the buffer and can be replayed with ssd1306_replay_log,
+ * e.g. after it was dumped to the host.
+ */
+typedef struct ssd1306_recorder_t
+{
+    uint8_t* buffer;                        /**< Log memory. */
+    size_t size;                            /**< Size of the log memory. */
+    size_t used;                            /**< Log length in bytes, header included. */
+    uint64_t last_us;                       /**< Time of the last record or of the log start. */
+    uint32_t dropped;                       /**< Records not logged for lack of space, the log ends at the first one. */
+    ssd1306_transport_writev_t writev;      /**< Transport transactions are forwarded to or NULL. */
+    void* user_data;                        /**< User data pointer passed to the forwarded transport. */
+}
+ssd1306_recorder_t;
+
+
+/**
+ * @brief Starts an empty log, timestamps are counted from now.
+ * Pass ssd1306_recorder_writev with the recorder as user data to ssd1306_init_transport_v to record the instance,
+ * then ssd1306_recorder_mark_frame to ssd1306_set_flush_hook to mark where frames end.
+ *
+ * @param recorder Pointer to the recorder to initialize.
+ * @param buffer Log memory, at least SSD1306_REPLAY_HEADER_SIZE bytes.
+ * @param size Size of the log memory.
+ * @param writev Transport transactions are forwarded to, or NULL to only record them.
+ * @param user_data User data pointer passed to the forwarded transport.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_recorder_init(
+    ssd1306_recorder_t* recorder,
+    uint8_t buffer[],
+    size_t size,
+    ssd1306_transport_writev_t writev,
+    void* user_data
+);
+
+/**
+ * @brief Gather transport logging the transaction and forwarding it.
+ * Transactions are logged whether or not the forwarded transport fails, as the driver sent them.
+ *
+ * @param user_data Pointer to the recorder.
+ * @param segments Transaction segments, the first byte is the control byte.
+ * @param segment_count Number of segments.
+ * @return Error code of the forwarded transport, SSD1306_ERR_OK if there is none.
+ */
+ssd1306_err_t ssd1306_recorder_writev(
+    void* user_data,
+    const ssd1306_iovec_t segments[],
+    size_t segment_count
+);
+
+/**
+ * @brief Flush hook logging a frame marker, so replayed frames match driver flushes however many transactions they took.
+ *
+ * @param user_data Pointer to the recorder.
+ */
+void ssd1306_recorder_mark_frame(
+    void* user_data
+);
+
+/**
+ * @brief Empties the log, e.g. to record only the rendering loop after ssd1306_init_display.
+ *
+ * @param recorder Pointer to the recorder.
+ */
+void ssd1306_recorder_reset(
+    ssd1306_recorder_t* recorder
+);
+
+
+#endif //SSD1306_RECORDER_H
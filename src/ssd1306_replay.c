@@ -0,0 +1,399 @@
+#include <string.h>
+
+#include "ssd1306_replay.h"
+
+
+static bool ssd1306_replay_read_varint(
+    const uint8_t log[],
+    size_t log_len,
+    size_t* offset,
+    uint64_t* value
+);
+static size_t ssd1306_replay_cmd_arg_count(
+    uint8_t cmd
+);
+static void ssd1306_replay_sim_cmd(
+    ssd1306_replay_sim_t* sim,
+    const uint8_t cmd[]
+);
+static void ssd1306_replay_sim_data(
+    ssd1306_replay_sim_t* sim,
+    uint8_t data
+);
+static bool ssd1306_replay_sim_is_lit(
+    const ssd1306_replay_sim_t* sim,
+    uint8_t x,
+    uint8_t y
+);
+
+
+bool ssd1306_replay_read_varint(
+    const uint8_t log[],
+    size_t log_len,
+    size_t* offset,
+    uint64_t* value
+)
+{
+    *value = 0;
+
+    for(unsigned int shift = 0; *offset < log_len && shift < 64; shift += 7)
+    {
+        uint8_t byte = log[(*offset)++];
+
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if(!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t ssd1306_replay_cmd_arg_count(
+    uint8_t cmd
+)
+{
+    switch(cmd)
+    {
+        case 0x20: case 0x23: case 0x81: case 0x8D: case 0xA8:
+        case 0xD3: case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27: case 0x2C: case 0x2D:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+void ssd1306_replay_sim_cmd(
+    ssd1306_replay_sim_t* sim,
+    const uint8_t cmd[]
+)
+{
+    // Single byte commands carry their argument in the low bits
+    if(cmd[0] <= 0x0F)
+    {
+        sim->col = (sim->col & 0xF0) | cmd[0];
+        return;
+    }
+    if(cmd[0] <= 0x1F)
+    {
+        sim->col = ((cmd[0] & 0x07) << 4) | (sim->col & 0x0F);
+        return;
+    }
+    if(cmd[0] >= 0x40 && cmd[0] <= 0x7F)
+    {
+        sim->start_line = cmd[0] & 0x3F;
+        return;
+    }
+    if(cmd[0] >= 0xB0 && cmd[0] <= 0xB7)
+    {
+        sim->page = cmd[0] & 0x07;
+        return;
+    }
+
+    switch(cmd[0])
+    {
+        case 0x20:
+            sim->mem_mode = cmd[1] & 0x03;
+            break;
+        case 0x21:
+            sim->col_start = cmd[1] & 0x7F;
+            sim->col_end = cmd[2] & 0x7F;
+            sim->col = sim->col_start;
+            break;
+        case 0x22:
+            sim->page_start = cmd[1] & 0x07;
+            sim->page_end = cmd[2] & 0x07;
+            sim->page = sim->page_start;
+            break;
+        case 0x81:
+            sim->contrast = cmd[1];
+            break;
+        case 0xA0:
+        case 0xA1:
+            sim->is_seg_remapped = cmd[0] & 0x01;
+            break;
+        case 0xA4:
+        case 0xA5:
+            sim->is_ram_ignored = cmd[0] & 0x01;
+            break;
+        case 0xA6:
+        case 0xA7:
+            sim->is_inverted = cmd[0] & 0x01;
+            break;
+        case 0xA8:
+            sim->mux_ratio = (cmd[1] & 0x3F) < 15 ? sim->mux_ratio : cmd[1] & 0x3F;
+            break;
+        case 0xAE:
+        case 0xAF:
+            sim->is_display_on = cmd[0] & 0x01;
+            break;
+        case 0xC0:
+        case 0xC8:
+            sim->is_com_remapped = cmd[0] & 0x08;
+            break;
+        case 0xD3:
+            sim->display_offset = cmd[1] & 0x3F;
+            break;
+        case 0x2C:
+        case 0x2D:
+            // One column content scroll moves RAM itself, columns wrap around inside the range
+            for(uint8_t page = cmd[2] & 0x07; page <= (cmd[4] & 0x07); ++page)
+            {
+                uint8_t* row = sim->ram[page];
+                uint8_t col_start = cmd[5] & 0x7F;
+                uint8_t col_end = cmd[6] & 0x7F;
+
+                if(col_start >= col_end)
+                {
+                    continue;
+                }
+                if(cmd[0] == 0x2D)
+                {
+                    uint8_t first = row[col_start];
+
+                    memmove(&row[col_start], &row[col_start + 1], col_end - col_start);
+                    row[col_end] = first;
+                }
+                else
+                {
+                    uint8_t last = row[col_end];
+
+                    memmove(&row[col_start + 1], &row[col_start], col_end - col_start);
+                    row[col_start] = last;
+                }
+            }
+            break;
+        case 0x23: case 0x26: case 0x27: case 0x29: case 0x2A: case 0x2E: case 0x2F:
+        case 0x8D: case 0xA3: case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB: case 0xE3:
+            break;
+        default:
+            ++sim->unknown_cmds;
+            break;
+    }
+}
+
+void ssd1306_replay_sim_data(
+    ssd1306_replay_sim_t* sim,
+    uint8_t data
+)
+{
+    sim->ram[sim->page % (SSD1306_REPLAY_SIM_HEIGHT / 8)][sim->col % SSD1306_REPLAY_SIM_WIDTH] = data;
+
+    // Pointers wrap inside the address window, page mode only wraps the column
+    if(sim->mem_mode == 1)
+    {
+        if(sim->page++ >= sim->page_end)
+        {
+            sim->page = sim->page_start;
+            sim->col = sim->col >= sim->col_end ? sim->col_start : sim->col + 1;
+        }
+    }
+    else if(sim->mem_mode == 2)
+    {
+        sim->col = sim->col >= SSD1306_REPLAY_SIM_WIDTH - 1 ? 0 : sim->col + 1;
+    }
+    else
+    {
+        if(sim->col++ >= sim->col_end)
+        {
+            sim->col = sim->col_start;
+            sim->page = sim->page >= sim->page_end ? sim->page_start : sim->page + 1;
+        }
+    }
+}
+
+bool ssd1306_replay_sim_is_lit(
+    const ssd1306_replay_sim_t* sim,
+    uint8_t x,
+    uint8_t y
+)
+{
+    uint8_t row_count = sim->mux_ratio + 1;
+
+    if(!sim->is_display_on || y >= row_count)
+    {
+        return false;
+    }
+    if(sim->is_ram_ignored)
+    {
+        return true;
+    }
+
+    // Panel row y is driven by a COM, which shows the RAM row the scan reached, moved by the start line.
+    // Common modules wire SEG0 and COM0 to the far edges, so remapped outputs show RAM upright
+    uint8_t com = sim->is_com_remapped ? y : row_count - 1 - y;
+    uint8_t row = (com + sim->display_offset + sim->start_line) % SSD1306_REPLAY_SIM_HEIGHT;
+    uint8_t col = sim->is_seg_remapped ? x : SSD1306_REPLAY_SIM_WIDTH - 1 - x;
+    bool is_set = (sim->ram[row / 8][col] >> (row % 8)) & 1;
+
+    return is_set != sim->is_inverted;
+}
+
+void ssd1306_replay_sim_init(
+    ssd1306_replay_sim_t* sim
+)
+{
+    memset(sim, 0, sizeof(ssd1306_replay_sim_t));
+
+    sim->mem_mode = 2;
+    sim->col_end = SSD1306_REPLAY_SIM_WIDTH - 1;
+    sim->page_end = SSD1306_REPLAY_SIM_HEIGHT / 8 - 1;
+    sim->mux_ratio = SSD1306_REPLAY_SIM_HEIGHT - 1;
+    sim->contrast = 0x7F;
+}
+
+void ssd1306_replay_sim_write(
+    ssd1306_replay_sim_t* sim,
+    uint8_t type,
+    const uint8_t payload[],
+    size_t payload_len
+)
+{
+    bool is_data = type & 0x40;
+    size_t i = 0;
+
+    while(i < payload_len)
+    {
+        if(is_data)
+        {
+            ssd1306_replay_sim_data(sim, payload[i++]);
+            continue;
+        }
+
+        // Truncated commands are dropped like the controller drops them at the stop condition
+        size_t cmd_len = 1 + ssd1306_replay_cmd_arg_count(payload[i]);
+
+        if(i + cmd_len > payload_len)
+        {
+            break;
+        }
+
+        ssd1306_replay_sim_cmd(sim, &payload[i]);
+        i += cmd_len;
+    }
+}
+
+void ssd1306_replay_sim_render_pbm(
+    const ssd1306_replay_sim_t* sim,
+    uint8_t pbm[]
+)
+{
+    size_t header_len = sizeof(SSD1306_REPLAY_PBM_HEADER) - 1;
+    uint8_t* pixels = pbm + header_len;
+
+    memcpy(pbm, SSD1306_REPLAY_PBM_HEADER, header_len);
+    memset(pixels, 0, SSD1306_REPLAY_PBM_SIZE - header_len);
+
+    // PBM bits are 1 for black, so unlit pixels are set
+    for(uint8_t y = 0; y < SSD1306_REPLAY_SIM_HEIGHT; ++y)
+    {
+        for(uint8_t x = 0; x < SSD1306_REPLAY_SIM_WIDTH; ++x)
+        {
+            if(!ssd1306_replay_sim_is_lit(sim, x, y))
+            {
+                pixels[(y * SSD1306_REPLAY_SIM_WIDTH + x) / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+}
+
+bool ssd1306_replay_next_record(
+    const uint8_t log[],
+    size_t log_len,
+    size_t* offset,
+    uint64_t* timestamp_us,
+    ssd1306_replay_record_t* record
+)
+{
+    size_t pos = *offset;
+    uint64_t delta_us;
+    uint64_t payload_len;
+
+    if(pos >= log_len)
+    {
+        return false;
+    }
+
+    record->type = log[pos++];
+
+    if(!ssd1306_replay_read_varint(log, log_len, &pos, &delta_us)
+    || !ssd1306_replay_read_varint(log, log_len, &pos, &payload_len)
+    || payload_len > log_len - pos)
+    {
+        return false;
+    }
+
+    *timestamp_us += delta_us;
+
+    record->timestamp_us = *timestamp_us;
+    record->payload = &log[pos];
+    record->payload_len = payload_len;
+
+    *offset = pos + payload_len;
+
+    return true;
+}
+
+bool ssd1306_replay_log(
+    const uint8_t log[],
+    size_t log_len,
+    ssd1306_replay_sim_t* sim,
+    ssd1306_replay_stats_t* stats,
+    ssd1306_replay_frame_cb_t on_frame,
+    void* user_data
+)
+{
+    memset(stats, 0, sizeof(ssd1306_replay_stats_t));
+
+    if(log_len < SSD1306_REPLAY_HEADER_SIZE
+    || memcmp(log, SSD1306_REPLAY_MAGIC, SSD1306_REPLAY_MAGIC_SIZE) != 0
+    || log[SSD1306_REPLAY_MAGIC_SIZE] != SSD1306_REPLAY_VERSION)
+    {
+        return false;
+    }
+
+    size_t offset = SSD1306_REPLAY_HEADER_SIZE;
+    uint64_t timestamp_us = 0;
+    ssd1306_replay_record_t record;
+
+    while(ssd1306_replay_next_record(log, log_len, &offset, &timestamp_us, &record))
+    {
+        stats->duration_us = record.timestamp_us;
+
+        if(record.type == SSD1306_REPLAY_TYPE_FRAME)
+        {
+            if(on_frame != NULL)
+            {
+                on_frame(user_data, sim, stats->frames, record.timestamp_us);
+            }
+
+            ++stats->frames;
+            continue;
+        }
+
+        ssd1306_replay_sim_write(sim, record.type, record.payload, record.payload_len);
+
+        ++stats->transactions;
+        stats->bytes += record.payload_len + 1;
+
+        if(record.type & 0x40)
+        {
+            ++stats->data_transactions;
+            stats->data_bytes += record.payload_len;
+        }
+        else
+        {
+            ++stats->cmd_transactions;
+        }
+    }
+
+    return offset == log_len;
+}
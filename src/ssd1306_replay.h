@@ -0,0 +1,211 @@
+/**
+ *
+ *  @file
+ *  @brief Command stream log format, SSD1306 simulator and log replayer
+ *
+ *  Has no Pico SDK dependency, so recorded logs can be replayed on the host.
+ *
+ **/
+
+#ifndef SSD1306_REPLAY_H
+#define SSD1306_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @def SSD1306_REPLAY_MAGIC
+ * @brief First bytes of a log.
+ *
+ * @def SSD1306_REPLAY_MAGIC_SIZE
+ * @brief Size of SSD1306_REPLAY_MAGIC without the null terminator.
+ *
+ * @def SSD1306_REPLAY_VERSION
+ * @brief Log format version, the byte following the magic.
+ *
+ * @def SSD1306_REPLAY_TYPE_FRAME
+ * @brief Type of the empty record ending a frame, written at the end of every flush. No control byte has all bits set.
+ *
+ * @def SSD1306_REPLAY_HEADER_SIZE
+ * @brief Size of the log header: magic and version.
+ *
+ * @def SSD1306_REPLAY_MAX_RECORD_HEAD_SIZE
+ * @brief Largest size of a record without its payload: type, 64-bit time varint and 32-bit length varint.
+ *
+ * @def SSD1306_REPLAY_SIM_WIDTH
+ * @brief Simulated display width in pixels.
+ *
+ * @def SSD1306_REPLAY_SIM_HEIGHT
+ * @brief Simulated display height in pixels.
+ *
+ * @def SSD1306_REPLAY_PBM_HEADER
+ * @brief Header of a rendered frame image.
+ *
+ * @def SSD1306_REPLAY_PBM_SIZE
+ * @brief Size of a rendered frame image: binary PBM header and 1 bpp row-major pixels.
+ */
+#define SSD1306_REPLAY_MAGIC                    "SSDR"
+#define SSD1306_REPLAY_MAGIC_SIZE               4u
+#define SSD1306_REPLAY_VERSION                  2u
+#define SSD1306_REPLAY_TYPE_FRAME               0xFFu
+#define SSD1306_REPLAY_HEADER_SIZE              (SSD1306_REPLAY_MAGIC_SIZE + 1u)
+#define SSD1306_REPLAY_MAX_RECORD_HEAD_SIZE     (1u + 10u + 5u)
+#define SSD1306_REPLAY_SIM_WIDTH                128u
+#define SSD1306_REPLAY_SIM_HEIGHT               64u
+#define SSD1306_REPLAY_PBM_HEADER               "P4\n128 64\n"
+#define SSD1306_REPLAY_PBM_SIZE                 (sizeof(SSD1306_REPLAY_PBM_HEADER) - 1 + SSD1306_REPLAY_SIM_WIDTH * SSD1306_REPLAY_SIM_HEIGHT / 8)
+
+
+/**
+ * @struct ssd1306_replay_record_t
+ * @brief Logged transaction or frame marker. In a log it is stored as the type byte, the varint time since the previous record
+ * in microseconds, the varint payload length and the payload. Varints are little endian base 128.
+ */
+typedef struct ssd1306_replay_record_t
+{
+    uint8_t type;               /**< Control byte the transaction starts with, e.g. 0x00 for commands and 0x40 for RAM data, or SSD1306_REPLAY_TYPE_FRAME. */
+    uint64_t timestamp_us;      /**< Time since the log was started. */
+    const uint8_t* payload;     /**< Transaction bytes following the control byte. */
+    size_t payload_len;         /**< Number of payload bytes. */
+}
+ssd1306_replay_record_t;
+
+/**
+ * @struct ssd1306_replay_sim_t
+ * @brief Controller state rebuilt from the command stream: display RAM, addressing and the settings shaping the image.
+ * One column content scrolls move RAM, continuous scrolling, fading and zoom are accepted but not simulated.
+ */
+typedef struct ssd1306_replay_sim_t
+{
+    uint8_t ram[SSD1306_REPLAY_SIM_HEIGHT / 8][SSD1306_REPLAY_SIM_WIDTH];   /**< Display RAM, page-major. */
+    uint8_t mem_mode;           /**< Memory addressing mode: 0 horizontal, 1 vertical, 2 page. */
+    uint8_t col_start;          /**< First column of the address window. */
+    uint8_t col_end;            /**< Last column of the address window. */
+    uint8_t page_start;         /**< First page of the address window. */
+    uint8_t page_end;           /**< Last page of the address window. */
+    uint8_t col;                /**< Column address pointer. */
+    uint8_t page;               /**< Page address pointer. */
+    uint8_t start_line;         /**< Display start line. */
+    uint8_t display_offset;     /**< Vertical shift by COM. */
+    uint8_t mux_ratio;          /**< Multiplex ratio minus one. */
+    uint8_t contrast;           /**< Contrast level. */
+    bool is_seg_remapped;       /**< Column 127 is mapped to SEG0. */
+    bool is_com_remapped;       /**< COM outputs are scanned from COM[N-1] to COM0. */
+    bool is_inverted;           /**< Lit pixels are off and unlit ones on. */
+    bool is_ram_ignored;        /**< Entire display is on regardless of RAM. */
+    bool is_display_on;         /**< Display is on. */
+    uint32_t unknown_cmds;      /**< Number of command bytes not recognized as commands. */
+}
+ssd1306_replay_sim_t;
+
+/**
+ * @struct ssd1306_replay_stats_t
+ * @brief Bus statistics of a replayed log, counted the same way as by the driver.
+ */
+typedef struct ssd1306_replay_stats_t
+{
+    uint32_t transactions;          /**< Number of transactions. */
+    uint32_t cmd_transactions;      /**< Number of command transactions. */
+    uint32_t data_transactions;     /**< Number of RAM data transactions. */
+    uint32_t bytes;                 /**< Number of bytes following the address byte, control bytes included. */
+    uint32_t data_bytes;            /**< Number of RAM data bytes. */
+    uint32_t frames;                /**< Number of frames, one per frame marker, i.e. per driver flush. */
+    uint64_t duration_us;           /**< Time of the last record, frame markers included. */
+}
+ssd1306_replay_stats_t;
+
+/**
+ * @brief Callback invoked with the simulator state at every frame marker.
+ *
+ * @param user_data User data pointer passed to ssd1306_replay_log.
+ * @param sim Simulator state.
+ * @param frame_idx Index of the frame.
+ * @param timestamp_us Time of the frame marker.
+ */
+typedef void (*ssd1306_replay_frame_cb_t)(
+    void* user_data,
+    const ssd1306_replay_sim_t* sim,
+    uint32_t frame_idx,
+    uint64_t timestamp_us
+);
+
+
+/**
+ * @brief Initializes a simulator to the controller reset state.
+ *
+ * @param sim Pointer to the simulator.
+ */
+void ssd1306_replay_sim_init(
+    ssd1306_replay_sim_t* sim
+);
+
+/**
+ * @brief Applies one transaction to the simulator.
+ *
+ * @param sim Pointer to the simulator.
+ * @param type Control byte the transaction starts with.
+ * @param payload Transaction bytes following the control byte.
+ * @param payload_len Number of payload bytes.
+ */
+void ssd1306_replay_sim_write(
+    ssd1306_replay_sim_t* sim,
+    uint8_t type,
+    const uint8_t payload[],
+    size_t payload_len
+);
+
+/**
+ * @brief Renders the visible image as a binary PBM, lit pixels white.
+ * Mapping of RAM to the panel follows start line, display offset, multiplex ratio, remaps and inversion.
+ * Panel is wired like common modules: RAM is shown upright with both SEG and COM remaps on, as set by ssd1306_init_display.
+ *
+ * @param sim Pointer to the simulator.
+ * @param pbm Buffer of SSD1306_REPLAY_PBM_SIZE bytes to store the image in.
+ */
+void ssd1306_replay_sim_render_pbm(
+    const ssd1306_replay_sim_t* sim,
+    uint8_t pbm[]
+);
+
+/**
+ * @brief Reads the record at a log position.
+ *
+ * @param log Log bytes.
+ * @param log_len Number of log bytes.
+ * @param offset Pointer to the position of the record, header excluded. Advanced past the record.
+ * @param timestamp_us Pointer to the time of the previous record. Updated to the time of the record.
+ * @param record Pointer to store the record.
+ * @return False at the end of the log or if the record is truncated.
+ */
+bool ssd1306_replay_next_record(
+    const uint8_t log[],
+    size_t log_len,
+    size_t* offset,
+    uint64_t* timestamp_us,
+    ssd1306_replay_record_t* record
+);
+
+/**
+ * @brief Feeds a whole log into a simulator, counts bus statistics and reports every frame.
+ * Frame markers are not transactions, they are neither fed to the simulator nor counted as bus traffic.
+ *
+ * @param log Log bytes, header included.
+ * @param log_len Number of log bytes.
+ * @param sim Pointer to a simulator, usually freshly initialized.
+ * @param stats Pointer to store the bus statistics.
+ * @param on_frame Frame callback or NULL.
+ * @param user_data User data pointer passed to the callback.
+ * @return False if the header is not recognized or the log is truncated. Records before the truncation are replayed.
+ */
+bool ssd1306_replay_log(
+    const uint8_t log[],
+    size_t log_len,
+    ssd1306_replay_sim_t* sim,
+    ssd1306_replay_stats_t* stats,
+    ssd1306_replay_frame_cb_t on_frame,
+    void* user_data
+);
+
+
+#endif //SSD1306_REPLAY_H
@@ -0,0 +1,48 @@
+/**
+ *
+ *  @file
+ *  @brief SSD1306 constants shared by the driver and host code
+ *
+ *  Has no Pico SDK dependency, so protocol cores and host tools use the same values as the driver.
+ *
+ **/
+
+#ifndef SSD1306_SPEC_H
+#define SSD1306_SPEC_H
+
+/**
+ * @def SSD1306_HEIGHT
+ * @brief Height of the SSD1306 display in pixels.
+ *
+ * @def SSD1306_WIDTH
+ * @brief Width of the SSD1306 display in pixels.
+ *
+ * @def SSD1306_PAGE_HEIGHT
+ * @brief Height of each page in the SSD1306 display in pixels.
+ *
+ * @def SSD1306_PAGE_COUNT
+ * @brief Number of pages in the SSD1306 display.
+ *
+ * @def SSD1306_RAM_BUFF_SIZE
+ * @brief Size of the RAM buffer for the SSD1306 display in bytes.
+ *
+ * @def SSD1306_I2C_CLOCKS_PER_BYTE
+ * @brief I2C clocks taken by one byte on the wire: 8 data bits and ACK.
+ *
+ * @def SSD1306_I2C_TXN_OVERHEAD_CLOCKS
+ * @brief I2C clocks taken by START and STOP conditions of one transaction.
+ *
+ * @def SSD1306_I2C_TXN_GAP_NS
+ * @brief Bus free time between two transactions in nanoseconds.
+ */
+#define SSD1306_HEIGHT                          64u
+#define SSD1306_WIDTH                           128u
+#define SSD1306_PAGE_HEIGHT                     8u
+#define SSD1306_PAGE_COUNT                      (SSD1306_HEIGHT / SSD1306_PAGE_HEIGHT)
+#define SSD1306_RAM_BUFF_SIZE                   (SSD1306_PAGE_COUNT * SSD1306_WIDTH) 
+#define SSD1306_I2C_CLOCKS_PER_BYTE             9u
+#define SSD1306_I2C_TXN_OVERHEAD_CLOCKS         2u
+#define SSD1306_I2C_TXN_GAP_NS                  1300u
+
+
+#endif //SSD1306_SPEC_H
@@ -0,0 +1,170 @@
+#include <string.h>
+
+#include "ssd1306_viewport.h"
+
+
+static uint16_t ssd1306_viewport_src_page(
+    uint16_t y,
+    uint8_t ram_page
+);
+static bool ssd1306_viewport_is_split(
+    uint16_t y,
+    uint8_t ram_page
+);
+static const uint8_t* ssd1306_viewport_get_page(
+    ssd1306_viewport_t* viewport,
+    uint8_t ram_page
+);
+static ssd1306_err_t ssd1306_viewport_send_pages(
+    ssd1306_viewport_t* viewport,
+    uint8_t page_mask
+);
+
+
+uint16_t ssd1306_viewport_src_page(
+    uint16_t y,
+    uint8_t ram_page
+)
+{
+    uint16_t top_page = y / SSD1306_PAGE_HEIGHT;
+
+    return top_page + (ram_page + SSD1306_PAGE_COUNT - top_page % SSD1306_PAGE_COUNT) % SSD1306_PAGE_COUNT;
+}
+
+bool ssd1306_viewport_is_split(
+    uint16_t y,
+    uint8_t ram_page
+)
+{
+    return y % SSD1306_PAGE_HEIGHT != 0 && ram_page == (y / SSD1306_PAGE_HEIGHT) % SSD1306_PAGE_COUNT;
+}
+
+const uint8_t* ssd1306_viewport_get_page(
+    ssd1306_viewport_t* viewport,
+    uint8_t ram_page
+)
+{
+    const uint8_t* src = viewport->canvas.buffer + ssd1306_viewport_src_page(viewport->y, ram_page) * SSD1306_WIDTH;
+
+    if(!ssd1306_viewport_is_split(viewport->y, ram_page))
+    {
+        return src;
+    }
+
+    // Rows above the window top are shown at the bottom, they come from the page 8 pages below
+    const uint8_t* bottom = src + SSD1306_PAGE_COUNT * SSD1306_WIDTH;
+    uint8_t mask = 0xFF << (viewport->y % SSD1306_PAGE_HEIGHT);
+
+    for(size_t i = 0; i < SSD1306_WIDTH; ++i)
+    {
+        viewport->split_page[i] = (src[i] & mask) | (bottom[i] & ~mask);
+    }
+
+    return viewport->split_page;
+}
+
+ssd1306_err_t ssd1306_viewport_send_pages(
+    ssd1306_viewport_t* viewport,
+    uint8_t page_mask
+)
+{
+    uint8_t page = 0;
+
+    // Runs of consecutive pages are gathered into one data transaction
+    while(page < SSD1306_PAGE_COUNT)
+    {
+        if(!(page_mask & (1 << page)))
+        {
+            ++page;
+            continue;
+        }
+
+        ssd1306_iovec_t pages[SSD1306_PAGE_COUNT];
+        uint8_t page_start = page;
+
+        while(page < SSD1306_PAGE_COUNT && (page_mask & (1 << page)))
+        {
+            pages[page - page_start].data = ssd1306_viewport_get_page(viewport, page);
+            pages[page - page_start].len = SSD1306_WIDTH;
+            ++page;
+        }
+
+        ssd1306_err_t error = ssd1306_send_area_v(
+            page_start, page - 1,
+            0, SSD1306_WIDTH - 1,
+            pages, page - page_start
+        );
+
+        if(error != SSD1306_ERR_OK)
+        {
+            return error;
+        }
+    }
+
+    return ssd1306_set_display_start_line(viewport->y % SSD1306_HEIGHT);
+}
+
+ssd1306_err_t ssd1306_viewport_init(
+    ssd1306_viewport_t* viewport,
+    uint8_t buffer[],
+    uint16_t height
+)
+{
+    if(viewport == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(height < SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    viewport->y = 0;
+
+    return ssd1306_canvas_init(&viewport->canvas, buffer, SSD1306_WIDTH, height);
+}
+
+ssd1306_err_t ssd1306_viewport_flush(
+    ssd1306_viewport_t* viewport
+)
+{
+    if(viewport == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    return ssd1306_viewport_send_pages(viewport, 0xFF);
+}
+
+ssd1306_err_t ssd1306_viewport_pan_to(
+    ssd1306_viewport_t* viewport,
+    uint16_t y
+)
+{
+    if(viewport == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(y > viewport->canvas.height - SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    uint8_t page_mask = 0;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE_COUNT; ++page)
+    {
+        bool is_split = ssd1306_viewport_is_split(y, page);
+
+        if(ssd1306_viewport_src_page(y, page) != ssd1306_viewport_src_page(viewport->y, page)
+        || is_split != ssd1306_viewport_is_split(viewport->y, page)
+        || (is_split && y % SSD1306_PAGE_HEIGHT != viewport->y % SSD1306_PAGE_HEIGHT))
+        {
+            page_mask |= 1 << page;
+        }
+    }
+
+    viewport->y = y;
+
+    return ssd1306_viewport_send_pages(viewport, page_mask);
+}
@@ -0,0 +1,82 @@
+/**
+ *
+ *  @file
+ *  @brief Virtual canvas taller than the display with hardware assisted vertical panning
+ *
+ **/
+
+#ifndef SSD1306_VIEWPORT_H
+#define SSD1306_VIEWPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_VIEWPORT_BUFF_SIZE
+ * @brief Size in bytes of the buffer of a virtual canvas height pixels high, e.g. for a static array.
+ */
+#define SSD1306_VIEWPORT_BUFF_SIZE(height)      (SSD1306_WIDTH * ((height) / SSD1306_PAGE_HEIGHT))
+
+
+/**
+ * @struct ssd1306_viewport_t
+ * @brief Display sized window over a virtual canvas SSD1306_WIDTH wide and at least SSD1306_HEIGHT high.
+ *
+ * Display RAM is used as a ring of pages: canvas row r is kept in RAM row r % SSD1306_HEIGHT and the display
+ * start line is set to the top row of the window. Panning only rewrites RAM pages whose source rows change,
+ * so a page aligned pan costs one page per 8 rows. Unless the window is page aligned,
+ * its top and bottom edges share one RAM page, which is composed in split_page.
+ */
+typedef struct ssd1306_viewport_t
+{
+    ssd1306_canvas_t canvas;                /**< Virtual canvas. */
+    uint16_t y;                             /**< Top row of the window in the canvas. */
+    uint8_t split_page[SSD1306_WIDTH];      /**< RAM page shared by the window edges. */
+}
+ssd1306_viewport_t;
+
+
+/**
+ * @brief Initializes a viewport over a caller provided virtual canvas buffer. The window is at the top.
+ *
+ * @param viewport Pointer to the viewport to initialize.
+ * @param buffer Canvas buffer of SSD1306_VIEWPORT_BUFF_SIZE(height) bytes.
+ * @param height Canvas height in pixels, multiple of SSD1306_PAGE_HEIGHT and at least SSD1306_HEIGHT.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_viewport_init(
+    ssd1306_viewport_t* viewport,
+    uint8_t buffer[],
+    uint16_t height
+);
+
+/**
+ * @brief Sends the whole window and sets the display start line, e.g. after drawing into the canvas.
+ * Window is sent in a single data transaction read from the canvas in place.
+ *
+ * @param viewport Pointer to the viewport.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_viewport_flush(
+    ssd1306_viewport_t* viewport
+);
+
+/**
+ * @brief Moves the window and shows it, sending only RAM pages whose source rows change.
+ * Canvas must not be drawn since the last ssd1306_viewport_flush or ssd1306_viewport_pan_to.
+ *
+ * @param viewport Pointer to the viewport.
+ * @param y New top row of the window, at most canvas height - SSD1306_HEIGHT.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_viewport_pan_to(
+    ssd1306_viewport_t* viewport,
+    uint16_t y
+);
+
+
+#endif //SSD1306_VIEWPORT_H
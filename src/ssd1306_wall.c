@@ -0,0 +1,254 @@
+#include <string.h>
+#include <pico/multicore.h>
+
+#include "ssd1306_wall.h"
+
+
+static ssd1306_err_t ssd1306_wall_flush_panel(
+    const ssd1306_wall_t* wall,
+    const ssd1306_wall_panel_t* panel
+);
+static ssd1306_err_t ssd1306_wall_flush_bus(
+    const ssd1306_wall_t* wall,
+    uint8_t bus_idx
+);
+static void ssd1306_wall_worker();
+
+
+static bool ssd1306_wall_is_worker_started = false;
+
+
+ssd1306_err_t ssd1306_wall_init(
+    ssd1306_wall_t* wall,
+    uint8_t buffer[],
+    uint16_t width,
+    uint16_t height,
+    const ssd1306_wall_panel_t panels[],
+    size_t panel_count
+)
+{
+    if(wall == NULL || panels == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(height > SSD1306_WALL_MAX_PAGE_COUNT * SSD1306_PAGE_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    for(size_t i = 0; i < panel_count; ++i)
+    {
+        const ssd1306_wall_panel_t* panel = &panels[i];
+
+        if(panel->instance == NULL)
+        {
+            return SSD1306_ERR_NULL_DATA;
+        }
+        if(panel->x + SSD1306_WIDTH > width
+        || panel->y + SSD1306_HEIGHT > height
+        || panel->y % SSD1306_PAGE_HEIGHT != 0
+        || panel->bus_idx >= SSD1306_WALL_BUS_COUNT)
+        {
+            return SSD1306_ERR_INVALID_PANEL;
+        }
+    }
+
+    ssd1306_err_t error = ssd1306_canvas_init(&wall->canvas, buffer, width, height);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    wall->panels = panels;
+    wall->panel_count = panel_count;
+    wall->damage_page_mask = 0;
+
+    ssd1306_wall_damage(wall, 0, 0, width, height);
+
+    return SSD1306_ERR_OK;
+}
+
+void ssd1306_wall_damage(
+    ssd1306_wall_t* wall,
+    int x,
+    int y,
+    int w,
+    int h
+)
+{
+    // Nothing is drawn outside the clip rectangle
+    if(!ssd1306_gfx_clip_area(&wall->canvas, &x, &y, &w, &h))
+    {
+        return;
+    }
+
+    int x_end = x + w;
+    int y_end = y + h;
+
+    for(int page = y / SSD1306_PAGE_HEIGHT; page <= (y_end - 1) / SSD1306_PAGE_HEIGHT; ++page)
+    {
+        if(!(wall->damage_page_mask & (1 << page)))
+        {
+            wall->damage_page_mask |= 1 << page;
+            wall->damage_col_start[page] = x;
+            wall->damage_col_end[page] = x_end - 1;
+            continue;
+        }
+
+        if(x < wall->damage_col_start[page])
+        {
+            wall->damage_col_start[page] = x;
+        }
+        if(x_end - 1 > wall->damage_col_end[page])
+        {
+            wall->damage_col_end[page] = x_end - 1;
+        }
+    }
+}
+
+ssd1306_err_t ssd1306_wall_flush_panel(
+    const ssd1306_wall_t* wall,
+    const ssd1306_wall_panel_t* panel
+)
+{
+    uint8_t wall_page_first = panel->y / SSD1306_PAGE_HEIGHT;
+    uint8_t window_page_start;
+    uint8_t window_page_count;
+    ssd1306_err_t error = ssd1306_get_row_window(&window_page_start, &window_page_count);
+    int page_start = -1;
+    int page_end = -1;
+    int col_start = panel->x + SSD1306_WIDTH;
+    int col_end = panel->x - 1;
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    // Bounding window of the redrawn parts shown by the display, only pages of its row window are scanned
+    for(int page = window_page_start; page < window_page_start + window_page_count; ++page)
+    {
+        int wall_page = wall_page_first + page;
+
+        if(!(wall->damage_page_mask & (1 << wall_page)))
+        {
+            continue;
+        }
+
+        int page_col_start = wall->damage_col_start[wall_page] > panel->x ? wall->damage_col_start[wall_page] : panel->x;
+        int page_col_end = wall->damage_col_end[wall_page] < panel->x + SSD1306_WIDTH - 1 ? wall->damage_col_end[wall_page] : panel->x + SSD1306_WIDTH - 1;
+
+        if(page_col_start > page_col_end)
+        {
+            continue;
+        }
+
+        page_start = page_start < 0 ? page : page_start;
+        page_end = page;
+        col_start = page_col_start < col_start ? page_col_start : col_start;
+        col_end = page_col_end > col_end ? page_col_end : col_end;
+    }
+
+    if(page_start < 0)
+    {
+        return SSD1306_ERR_OK;
+    }
+
+    ssd1306_iovec_t rows[SSD1306_PAGE_COUNT];
+
+    for(int page = page_start; page <= page_end; ++page)
+    {
+        rows[page - page_start].data = &wall->canvas.buffer[(wall_page_first + page) * wall->canvas.width + col_start];
+        rows[page - page_start].len = col_end - col_start + 1;
+    }
+
+    return ssd1306_send_area_v(
+        page_start, page_end,
+        col_start - panel->x, col_end - panel->x,
+        rows, page_end - page_start + 1
+    );
+}
+
+ssd1306_err_t ssd1306_wall_flush_bus(
+    const ssd1306_wall_t* wall,
+    uint8_t bus_idx
+)
+{
+    ssd1306_instance_t* instance = ssd1306_get_instance();
+    ssd1306_err_t result = SSD1306_ERR_OK;
+
+    // A failing display doesn't hold back the others
+    for(size_t i = 0; i < wall->panel_count; ++i)
+    {
+        if(wall->panels[i].bus_idx != bus_idx)
+        {
+            continue;
+        }
+
+        ssd1306_select_instance(wall->panels[i].instance);
+
+        ssd1306_err_t error = ssd1306_wall_flush_panel(wall, &wall->panels[i]);
+
+        if(result == SSD1306_ERR_OK)
+        {
+            result = error;
+        }
+    }
+
+    ssd1306_select_instance(instance);
+
+    return result;
+}
+
+void ssd1306_wall_worker()
+{
+    while(true)
+    {
+        const ssd1306_wall_t* wall = (const ssd1306_wall_t*)(uintptr_t)multicore_fifo_pop_blocking();
+
+        multicore_fifo_push_blocking(ssd1306_wall_flush_bus(wall, 1));
+    }
+}
+
+ssd1306_err_t ssd1306_wall_flush(
+    ssd1306_wall_t* wall
+)
+{
+    if(wall == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    if(ssd1306_wall_is_worker_started)
+    {
+        multicore_fifo_push_blocking((uint32_t)(uintptr_t)wall);
+    }
+
+    ssd1306_err_t bus0_error = ssd1306_wall_flush_bus(wall, 0);
+    ssd1306_err_t bus1_error = ssd1306_wall_is_worker_started
+        ? (ssd1306_err_t)multicore_fifo_pop_blocking()
+        : ssd1306_wall_flush_bus(wall, 1);
+    ssd1306_err_t error = bus0_error != SSD1306_ERR_OK ? bus0_error : bus1_error;
+
+    // Failed areas are kept for the next flush
+    if(error == SSD1306_ERR_OK)
+    {
+        wall->damage_page_mask = 0;
+    }
+
+    return error;
+}
+
+ssd1306_err_t ssd1306_wall_start_worker()
+{
+    if(ssd1306_wall_is_worker_started)
+    {
+        return SSD1306_ERR_INITIALIZED;
+    }
+
+    multicore_launch_core1(ssd1306_wall_worker);
+    ssd1306_wall_is_worker_started = true;
+
+    return SSD1306_ERR_OK;
+}
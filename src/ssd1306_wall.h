@@ -0,0 +1,119 @@
+/**
+ *
+ *  @file
+ *  @brief Video wall of several displays presented as one canvas
+ *
+ **/
+
+#ifndef SSD1306_WALL_H
+#define SSD1306_WALL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_WALL_MAX_PAGE_COUNT
+ * @brief Maximum number of pages of the wall canvas.
+ *
+ * @def SSD1306_WALL_BUS_COUNT
+ * @brief Number of buses flushed in parallel, one per core.
+ */
+#define SSD1306_WALL_MAX_PAGE_COUNT         _u(16)
+#define SSD1306_WALL_BUS_COUNT              _u(2)
+
+
+/**
+ * @struct ssd1306_wall_panel_t
+ * @brief Display making up a part of the wall.
+ */
+typedef struct ssd1306_wall_panel_t
+{
+    ssd1306_instance_t* instance;   /**< Initialized instance of the display. */
+    uint16_t x;                     /**< Left column of the display in the wall. */
+    uint16_t y;                     /**< Top row of the display in the wall, multiple of SSD1306_PAGE_HEIGHT. */
+    uint8_t bus_idx;                /**< Bus of the display, displays sharing an I2C instance must share the bus. */
+}
+ssd1306_wall_panel_t;
+
+/**
+ * @struct ssd1306_wall_t
+ * @brief Canvas spanning several displays.
+ * Redrawn areas are tracked per canvas page and split per display on flush,
+ * so every display only receives the part of the area it shows.
+ */
+typedef struct ssd1306_wall_t
+{
+    ssd1306_canvas_t canvas;                                /**< Wall canvas. */
+    const ssd1306_wall_panel_t* panels;                     /**< Displays of the wall. */
+    size_t panel_count;                                     /**< Number of displays. */
+    uint16_t damage_col_start[SSD1306_WALL_MAX_PAGE_COUNT]; /**< First redrawn column of every page. */
+    uint16_t damage_col_end[SSD1306_WALL_MAX_PAGE_COUNT];   /**< Last redrawn column of every page. */
+    uint16_t damage_page_mask;                              /**< Pages redrawn since the last flush. */
+}
+ssd1306_wall_t;
+
+
+/**
+ * @brief Initializes a wall over a caller provided canvas buffer. The whole canvas is marked as redrawn.
+ *
+ * @param wall Pointer to the wall to initialize.
+ * @param buffer Canvas buffer of width * height / 8 bytes.
+ * @param width Canvas width in pixels.
+ * @param height Canvas height in pixels, multiple of SSD1306_PAGE_HEIGHT.
+ * @param panels Displays of the wall, kept by the wall.
+ * @param panel_count Number of displays.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_wall_init(
+    ssd1306_wall_t* wall,
+    uint8_t buffer[],
+    uint16_t width,
+    uint16_t height,
+    const ssd1306_wall_panel_t panels[],
+    size_t panel_count
+);
+
+/**
+ * @brief Marks an area of the canvas as redrawn. The area is clipped by the canvas clip rectangle, so areas clipped away while drawing cost nothing.
+ *
+ * @param wall Pointer to the wall.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ */
+void ssd1306_wall_damage(
+    ssd1306_wall_t* wall,
+    int x,
+    int y,
+    int w,
+    int h
+);
+
+/**
+ * @brief Sends the redrawn areas to the displays.
+ * Each display gets one data transaction read from the canvas in place, limited to the pages of its row window.
+ * With the worker started, displays of bus 1 are flushed by core 1 while core 0 flushes bus 0,
+ * so the wall takes the time of its slowest bus. Otherwise buses are flushed one after another.
+ * Instance selected on the calling core is kept.
+ *
+ * @param wall Pointer to the wall.
+ * @return API error code, the first error of any display.
+ */
+ssd1306_err_t ssd1306_wall_flush(
+    ssd1306_wall_t* wall
+);
+
+/**
+ * @brief Launches core 1 as the flush worker of bus 1. Core 1 must not be used by the application.
+ *
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_wall_start_worker();
+
+
+#endif //SSD1306_WALL_H
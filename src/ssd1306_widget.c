@@ -0,0 +1,562 @@
+#include <string.h>
+
+#include "ssd1306_widget.h"
+
+
+typedef enum ssd1306_widget_flag_t
+{
+    SSD1306_WIDGET_FLAG_IN_USE  = _u(0x01),
+    SSD1306_WIDGET_FLAG_VISIBLE = _u(0x02),
+    SSD1306_WIDGET_FLAG_DIRTY   = _u(0x04),
+    SSD1306_WIDGET_FLAG_REMOVED = _u(0x08),
+}
+ssd1306_widget_flag_t;
+
+
+static ssd1306_widget_t* ssd1306_widget_get(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+);
+static bool ssd1306_widget_is_descendant(
+    const ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    ssd1306_widget_id_t ancestor
+);
+static bool ssd1306_widget_is_shown(
+    const ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+);
+static void ssd1306_widget_mark_subtree(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    uint8_t flags
+);
+static bool ssd1306_widget_overlap(
+    const ssd1306_widget_t* a,
+    const ssd1306_widget_t* b
+);
+static void ssd1306_widget_add_damage(
+    ssd1306_widget_layer_t* layer,
+    const ssd1306_widget_t* widget
+);
+static void ssd1306_widget_draw(
+    ssd1306_widget_layer_t* layer,
+    const ssd1306_widget_t* widget
+);
+
+
+ssd1306_err_t ssd1306_widget_layer_init(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_canvas_t* canvas,
+    const ssd1306_font_t* font
+)
+{
+    if(layer == NULL || canvas == NULL || font == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(canvas->width != SSD1306_WIDTH || canvas->height != SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_CANVAS_SIZE;
+    }
+
+    memset(layer, 0, sizeof(ssd1306_widget_layer_t));
+    layer->canvas = canvas;
+    layer->font = font;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_widget_t* ssd1306_widget_get(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+)
+{
+    if(layer == NULL || id >= SSD1306_WIDGET_POOL_SIZE)
+    {
+        return NULL;
+    }
+
+    ssd1306_widget_t* widget = &layer->pool[id];
+
+    if(!(widget->flags & SSD1306_WIDGET_FLAG_IN_USE) || (widget->flags & SSD1306_WIDGET_FLAG_REMOVED))
+    {
+        return NULL;
+    }
+
+    return widget;
+}
+
+bool ssd1306_widget_is_descendant(
+    const ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    ssd1306_widget_id_t ancestor
+)
+{
+    // Depth is bounded by the pool size even if the caller made a cycle
+    for(uint i = 0; i < SSD1306_WIDGET_POOL_SIZE && id != SSD1306_WIDGET_ID_NONE; ++i)
+    {
+        if(id == ancestor)
+        {
+            return true;
+        }
+
+        id = layer->pool[id].parent;
+    }
+
+    return false;
+}
+
+bool ssd1306_widget_is_shown(
+    const ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+)
+{
+    for(uint i = 0; i < SSD1306_WIDGET_POOL_SIZE && id != SSD1306_WIDGET_ID_NONE; ++i)
+    {
+        const ssd1306_widget_t* widget = &layer->pool[id];
+
+        if(!(widget->flags & SSD1306_WIDGET_FLAG_VISIBLE) || (widget->flags & SSD1306_WIDGET_FLAG_REMOVED))
+        {
+            return false;
+        }
+
+        id = widget->parent;
+    }
+
+    return true;
+}
+
+void ssd1306_widget_mark_subtree(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    uint8_t flags
+)
+{
+    for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+    {
+        if((layer->pool[i].flags & SSD1306_WIDGET_FLAG_IN_USE) && ssd1306_widget_is_descendant(layer, i, id))
+        {
+            layer->pool[i].flags |= flags;
+        }
+    }
+}
+
+ssd1306_err_t ssd1306_widget_create(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_type_t type,
+    ssd1306_widget_id_t parent,
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h,
+    ssd1306_widget_id_t* id
+)
+{
+    if(layer == NULL || id == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+    if(type >= SSD1306_WIDGET_TYPE_COUNT)
+    {
+        return SSD1306_ERR_INVALID_WIDGET_TYPE;
+    }
+    if(parent != SSD1306_WIDGET_ID_NONE && ssd1306_widget_get(layer, parent) == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+    if(x >= SSD1306_WIDTH || w == 0 || x + w > SSD1306_WIDTH)
+    {
+        return SSD1306_ERR_INVALID_COLUMN;
+    }
+    if(y >= SSD1306_HEIGHT || h == 0 || y + h > SSD1306_HEIGHT)
+    {
+        return SSD1306_ERR_INVALID_ROW;
+    }
+
+    for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+    {
+        ssd1306_widget_t* widget = &layer->pool[i];
+
+        if(widget->flags & SSD1306_WIDGET_FLAG_IN_USE)
+        {
+            continue;
+        }
+
+        memset(widget, 0, sizeof(ssd1306_widget_t));
+        widget->x = x;
+        widget->y = y;
+        widget->w = w;
+        widget->h = h;
+        widget->type = type;
+        widget->parent = parent;
+        widget->flags = SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_VISIBLE | SSD1306_WIDGET_FLAG_DIRTY;
+
+        *id = i;
+        return SSD1306_ERR_OK;
+    }
+
+    return SSD1306_ERR_WIDGET_POOL_FULL;
+}
+
+ssd1306_err_t ssd1306_widget_destroy(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+)
+{
+    if(ssd1306_widget_get(layer, id) == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+
+    ssd1306_widget_mark_subtree(layer, id, SSD1306_WIDGET_FLAG_REMOVED | SSD1306_WIDGET_FLAG_DIRTY);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_widget_set_value(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    int16_t value
+)
+{
+    ssd1306_widget_t* widget = ssd1306_widget_get(layer, id);
+
+    if(widget == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+
+    if(widget->value != value)
+    {
+        widget->value = value;
+        widget->flags |= SSD1306_WIDGET_FLAG_DIRTY;
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_widget_set_data(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    const void* data
+)
+{
+    ssd1306_widget_t* widget = ssd1306_widget_get(layer, id);
+
+    if(widget == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+
+    widget->data = data;
+    widget->flags |= SSD1306_WIDGET_FLAG_DIRTY;
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_widget_set_visible(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    bool is_visible
+)
+{
+    ssd1306_widget_t* widget = ssd1306_widget_get(layer, id);
+
+    if(widget == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+    if(!!(widget->flags & SSD1306_WIDGET_FLAG_VISIBLE) == is_visible)
+    {
+        return SSD1306_ERR_OK;
+    }
+
+    if(is_visible)
+    {
+        widget->flags |= SSD1306_WIDGET_FLAG_VISIBLE;
+    }
+    else
+    {
+        widget->flags &= ~SSD1306_WIDGET_FLAG_VISIBLE;
+    }
+
+    ssd1306_widget_mark_subtree(layer, id, SSD1306_WIDGET_FLAG_DIRTY);
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_widget_invalidate(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+)
+{
+    ssd1306_widget_t* widget = ssd1306_widget_get(layer, id);
+
+    if(widget == NULL)
+    {
+        return SSD1306_ERR_INVALID_WIDGET;
+    }
+
+    widget->flags |= SSD1306_WIDGET_FLAG_DIRTY;
+
+    return SSD1306_ERR_OK;
+}
+
+bool ssd1306_widget_overlap(
+    const ssd1306_widget_t* a,
+    const ssd1306_widget_t* b
+)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w
+        && a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+void ssd1306_widget_add_damage(
+    ssd1306_widget_layer_t* layer,
+    const ssd1306_widget_t* widget
+)
+{
+    uint8_t page_start = widget->y / SSD1306_PAGE_HEIGHT;
+    uint8_t page_end = (widget->y + widget->h - 1) / SSD1306_PAGE_HEIGHT;
+    uint8_t col_end = widget->x + widget->w - 1;
+
+    for(uint8_t page = page_start; page <= page_end; ++page)
+    {
+        if(!(layer->damage_page_mask & (1 << page)))
+        {
+            layer->damage_page_mask |= 1 << page;
+            layer->damage_col_start[page] = widget->x;
+            layer->damage_col_end[page] = col_end;
+            continue;
+        }
+
+        if(widget->x < layer->damage_col_start[page])
+        {
+            layer->damage_col_start[page] = widget->x;
+        }
+        if(col_end > layer->damage_col_end[page])
+        {
+            layer->damage_col_end[page] = col_end;
+        }
+    }
+}
+
+void ssd1306_widget_draw(
+    ssd1306_widget_layer_t* layer,
+    const ssd1306_widget_t* widget
+)
+{
+    ssd1306_canvas_t* canvas = layer->canvas;
+
+    // Widgets never draw outside their box
+    if(ssd1306_gfx_push_clip(canvas, widget->x, widget->y, widget->w, widget->h) != SSD1306_ERR_OK)
+    {
+        return;
+    }
+
+    switch(widget->type)
+    {
+        case SSD1306_WIDGET_PANEL:
+        {
+            if(widget->value != 0)
+            {
+                ssd1306_gfx_draw_rect(canvas, widget->x, widget->y, widget->w, widget->h, true);
+            }
+            break;
+        }
+        case SSD1306_WIDGET_LABEL:
+        {
+            const char* text = (const char*)widget->data;
+            int x = widget->x;
+
+            // Glyph crossing the box edge is cut by the clip
+            for(size_t i = 0; text != NULL && text[i] != 0 && x < widget->x + widget->w; ++i)
+            {
+                ssd1306_gfx_draw_char(canvas, x, widget->y, layer->font, text[i]);
+                x += layer->font->glyph_width;
+            }
+            break;
+        }
+        case SSD1306_WIDGET_PROGRESS_BAR:
+        {
+            int value = widget->value < 0 ? 0 : (widget->value > 100 ? 100 : widget->value);
+            int fill_w = (widget->w - 4) * value / 100;
+
+            ssd1306_gfx_draw_rect(canvas, widget->x, widget->y, widget->w, widget->h, true);
+            ssd1306_gfx_fill_rect(canvas, widget->x + 2, widget->y + 2, fill_w, widget->h - 4, true);
+            break;
+        }
+        case SSD1306_WIDGET_ICON:
+        {
+            if(widget->data != NULL)
+            {
+                ssd1306_gfx_draw_bitmap(canvas, widget->x, widget->y, (const uint8_t*)widget->data, widget->w, widget->h);
+            }
+            break;
+        }
+        case SSD1306_WIDGET_SPARKLINE:
+        {
+            const uint8_t* samples = (const uint8_t*)widget->data;
+            int count = widget->value > widget->w ? widget->w : widget->value;
+            int bottom = widget->y + widget->h - 1;
+            int prev_x = 0;
+            int prev_y = 0;
+
+            // Newest sample is the last one and sits at the right edge
+            for(int i = 0; samples != NULL && i < count; ++i)
+            {
+                int sample = samples[i] >= widget->h ? widget->h - 1 : samples[i];
+                int x = widget->x + widget->w - count + i;
+                int y = bottom - sample;
+
+                if(i == 0)
+                {
+                    ssd1306_gfx_set_pixel(canvas, x, y, true);
+                }
+                else
+                {
+                    ssd1306_gfx_draw_line(canvas, prev_x, prev_y, x, y, true);
+                }
+
+                prev_x = x;
+                prev_y = y;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    ssd1306_gfx_pop_clip(canvas);
+}
+
+ssd1306_err_t ssd1306_widget_layer_render(
+    ssd1306_widget_layer_t* layer
+)
+{
+    if(layer == NULL || layer->canvas == NULL)
+    {
+        return SSD1306_ERR_NULL_DATA;
+    }
+
+    ssd1306_widget_t* pool = layer->pool;
+    bool is_spreading = true;
+
+    // Redrawing a widget clears its box, so everything shown beneath or above it has to be redrawn too.
+    // Ancestors are skipped: children are expected to lie inside the content area of their parent.
+    while(is_spreading)
+    {
+        is_spreading = false;
+
+        for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+        {
+            if((pool[i].flags & (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+                != (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+            {
+                continue;
+            }
+
+            for(ssd1306_widget_id_t j = 0; j < SSD1306_WIDGET_POOL_SIZE; ++j)
+            {
+                if((pool[j].flags & SSD1306_WIDGET_FLAG_IN_USE)
+                && !(pool[j].flags & SSD1306_WIDGET_FLAG_DIRTY)
+                && ssd1306_widget_is_shown(layer, j)
+                && !ssd1306_widget_is_descendant(layer, i, j)
+                && ssd1306_widget_overlap(&pool[i], &pool[j]))
+                {
+                    pool[j].flags |= SSD1306_WIDGET_FLAG_DIRTY;
+                    is_spreading = true;
+                }
+            }
+        }
+    }
+
+    for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+    {
+        if((pool[i].flags & (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+            == (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+        {
+            ssd1306_gfx_fill_rect(layer->canvas, pool[i].x, pool[i].y, pool[i].w, pool[i].h, false);
+            ssd1306_widget_add_damage(layer, &pool[i]);
+        }
+    }
+
+    for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+    {
+        if((pool[i].flags & (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+            != (SSD1306_WIDGET_FLAG_IN_USE | SSD1306_WIDGET_FLAG_DIRTY))
+        {
+            continue;
+        }
+
+        if(ssd1306_widget_is_shown(layer, i))
+        {
+            ssd1306_widget_draw(layer, &pool[i]);
+        }
+    }
+
+    for(ssd1306_widget_id_t i = 0; i < SSD1306_WIDGET_POOL_SIZE; ++i)
+    {
+        pool[i].flags &= ~SSD1306_WIDGET_FLAG_DIRTY;
+
+        if(pool[i].flags & SSD1306_WIDGET_FLAG_REMOVED)
+        {
+            pool[i].flags = 0;
+        }
+    }
+
+    return SSD1306_ERR_OK;
+}
+
+ssd1306_err_t ssd1306_widget_layer_flush(
+    ssd1306_widget_layer_t* layer
+)
+{
+    ssd1306_err_t error = ssd1306_widget_layer_render(layer);
+
+    if(error != SSD1306_ERR_OK)
+    {
+        return error;
+    }
+
+    uint8_t window_page_start;
+    uint8_t window_page_count;
+
+    error = ssd1306_get_row_window(&window_page_start, &window_page_count);
+
+    // Damage outside of the row window is not scanned by the panel and is dropped
+    uint8_t window_page_end = window_page_start + window_page_count;
+    uint8_t page = window_page_start;
+
+    // Consecutive damaged pages share one address window spanning all their columns
+    while(page < window_page_end && error == SSD1306_ERR_OK)
+    {
+        if(!(layer->damage_page_mask & (1 << page)))
+        {
+            ++page;
+            continue;
+        }
+
+        uint8_t page_start = page;
+        uint8_t col_start = layer->damage_col_start[page];
+        uint8_t col_end = layer->damage_col_end[page];
+
+        while(page + 1 < window_page_end && (layer->damage_page_mask & (1 << (page + 1))))
+        {
+            ++page;
+            col_start = layer->damage_col_start[page] < col_start ? layer->damage_col_start[page] : col_start;
+            col_end = layer->damage_col_end[page] > col_end ? layer->damage_col_end[page] : col_end;
+        }
+
+        error = ssd1306_flush_area(layer->canvas->buffer + window_page_start * SSD1306_WIDTH, page_start, page, col_start, col_end);
+        ++page;
+    }
+
+    if(error == SSD1306_ERR_OK)
+    {
+        layer->damage_page_mask = 0;
+    }
+
+    return error;
+}
@@ -0,0 +1,211 @@
+/**
+ *
+ *  @file
+ *  @brief Retained-mode widget layer API header
+ *
+ **/
+
+#ifndef SSD1306_WIDGET_H
+#define SSD1306_WIDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ssd1306_driver.h"
+#include "ssd1306_gfx.h"
+
+/**
+ * @def SSD1306_WIDGET_POOL_SIZE
+ * @brief Number of widget slots in a widget layer.
+ *
+ * @def SSD1306_WIDGET_ID_NONE
+ * @brief Widget identifier meaning no widget, used as parent of top level widgets.
+ */
+#define SSD1306_WIDGET_POOL_SIZE    _u(32)
+#define SSD1306_WIDGET_ID_NONE      _u(0xFF)
+
+
+/**
+ * @enum ssd1306_widget_type_t
+ * @brief Enumeration of widget types.
+ */
+typedef enum ssd1306_widget_type_t
+{
+    SSD1306_WIDGET_PANEL,           /**< Container for other widgets. Framed if value is not 0. */
+    SSD1306_WIDGET_LABEL,           /**< Single line of text. Data is a null terminated string. */
+    SSD1306_WIDGET_PROGRESS_BAR,    /**< Framed bar. Value is fill percentage [0, 100]. */
+    SSD1306_WIDGET_ICON,            /**< Bitmap. Data is a page-major bitmap of the widget size. */
+    SSD1306_WIDGET_SPARKLINE,       /**< Line chart. Data is an array of w samples [0, h-1], value is the number of valid samples. */
+    SSD1306_WIDGET_TYPE_COUNT,      /**< Total number of valid values. */
+} ssd1306_widget_type_t;
+
+/**
+ * @brief Widget identifier, index of the widget in the layer pool.
+ */
+typedef uint8_t ssd1306_widget_id_t;
+
+/**
+ * @struct ssd1306_widget_t
+ * @brief Widget slot. Takes 12 bytes on RP2040.
+ */
+typedef struct ssd1306_widget_t
+{
+    const void* data;               /**< Type specific data. */
+    int16_t value;                  /**< Type specific value. */
+    uint8_t x;                      /**< Left column of the bounding box. */
+    uint8_t y;                      /**< Top row of the bounding box. */
+    uint8_t w;                      /**< Width of the bounding box. */
+    uint8_t h;                      /**< Height of the bounding box. */
+    uint8_t type : 3;               /**< Widget type. */
+    uint8_t flags : 5;              /**< Internal state flags. */
+    ssd1306_widget_id_t parent;     /**< Parent widget or SSD1306_WIDGET_ID_NONE. */
+}
+ssd1306_widget_t;
+
+/**
+ * @struct ssd1306_widget_layer_t
+ * @brief Widget pool drawing into a display sized canvas.
+ * Widgets are drawn in the pool order, so parents created first are drawn below their children.
+ */
+typedef struct ssd1306_widget_layer_t
+{
+    ssd1306_widget_t pool[SSD1306_WIDGET_POOL_SIZE];    /**< Widget slots. */
+    ssd1306_canvas_t* canvas;                           /**< Target canvas of SSD1306_WIDTH x SSD1306_HEIGHT. */
+    const ssd1306_font_t* font;                         /**< Font used by labels. */
+    uint8_t damage_col_start[SSD1306_PAGE_COUNT];       /**< First redrawn column of every page. */
+    uint8_t damage_col_end[SSD1306_PAGE_COUNT];         /**< Last redrawn column of every page. */
+    uint8_t damage_page_mask;                           /**< Pages redrawn since the last flush. */
+}
+ssd1306_widget_layer_t;
+
+
+/**
+ * @brief Initializes an empty widget layer.
+ *
+ * @param layer Pointer to the layer.
+ * @param canvas Pointer to a canvas of SSD1306_WIDTH x SSD1306_HEIGHT pixels.
+ * @param font Pointer to the font used by labels.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_layer_init(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_canvas_t* canvas,
+    const ssd1306_font_t* font
+);
+
+/**
+ * @brief Takes a free slot from the pool and creates a visible widget in it.
+ *
+ * @param layer Pointer to the layer.
+ * @param type Widget type.
+ * @param parent Parent widget or SSD1306_WIDGET_ID_NONE.
+ * @param x Left column of the bounding box.
+ * @param y Top row of the bounding box.
+ * @param w Width of the bounding box.
+ * @param h Height of the bounding box.
+ * @param id Pointer to store the widget identifier.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_create(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_type_t type,
+    ssd1306_widget_id_t parent,
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h,
+    ssd1306_widget_id_t* id
+);
+
+/**
+ * @brief Destroys a widget and all its descendants.
+ * Slots are released and areas cleared on the next render.
+ *
+ * @param layer Pointer to the layer.
+ * @param id Widget identifier.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_destroy(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+);
+
+/**
+ * @brief Sets the widget value. The widget is invalidated only if the value changes.
+ *
+ * @param layer Pointer to the layer.
+ * @param id Widget identifier.
+ * @param value New value.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_set_value(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    int16_t value
+);
+
+/**
+ * @brief Sets the widget data and invalidates the widget.
+ *
+ * @param layer Pointer to the layer.
+ * @param id Widget identifier.
+ * @param data New data.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_set_data(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    const void* data
+);
+
+/**
+ * @brief Shows or hides a widget together with its descendants.
+ *
+ * @param layer Pointer to the layer.
+ * @param id Widget identifier.
+ * @param is_visible Visibility.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_set_visible(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id,
+    bool is_visible
+);
+
+/**
+ * @brief Invalidates a widget whose data changed in place, e.g. label text or sparkline samples.
+ *
+ * @param layer Pointer to the layer.
+ * @param id Widget identifier.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_invalidate(
+    ssd1306_widget_layer_t* layer,
+    ssd1306_widget_id_t id
+);
+
+/**
+ * @brief Redraws invalidated widgets into the canvas.
+ * Widgets overlapping an invalidated one are redrawn as well, except its ancestors.
+ * Children are expected to lie inside the content area of their parent.
+ * Redrawn areas are accumulated until the next ssd1306_widget_layer_flush.
+ *
+ * @param layer Pointer to the layer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_layer_render(
+    ssd1306_widget_layer_t* layer
+);
+
+/**
+ * @brief Renders invalidated widgets and sends only the redrawn column spans to the display.
+ *
+ * @param layer Pointer to the layer.
+ * @return API error code.
+ */
+ssd1306_err_t ssd1306_widget_layer_flush(
+    ssd1306_widget_layer_t* layer
+);
+
+
+#endif //SSD1306_WIDGET_H
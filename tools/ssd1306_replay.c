@@ -0,0 +1,116 @@
+/**
+ *
+ *  @file
+ *  @brief Host tool replaying a recorded command stream, see ssd1306_recorder.h
+ *
+ *  Built with the host compiler by host/CMakeLists.txt, outside of the Pico SDK build.
+ *
+ *  Usage: ssd1306_replay LOG [PBM_PREFIX]
+ *  Prints bus statistics as JSON and, given a prefix, writes every frame to PBM_PREFIX_NNNN.pbm.
+ *  Diffing the logs or frames of two driver versions shows what the driver emits differently.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ssd1306_spec.h"
+#include "ssd1306_replay.h"
+
+
+void write_frame(void* user_data, const ssd1306_replay_sim_t* sim, uint32_t frame_idx, uint64_t timestamp_us);
+uint64_t model_i2c_time_us(const ssd1306_replay_stats_t* stats, unsigned int freq_khz);
+
+
+void write_frame(void* user_data, const ssd1306_replay_sim_t* sim, uint32_t frame_idx, uint64_t timestamp_us)
+{
+    const char* prefix = (const char*)user_data;
+    uint8_t pbm[SSD1306_REPLAY_PBM_SIZE];
+    char path[512];
+
+    // Frames are numbered, their time is in the log
+    (void)timestamp_us;
+
+    snprintf(path, sizeof(path), "%s_%04lu.pbm", prefix, (unsigned long)frame_idx);
+    ssd1306_replay_sim_render_pbm(sim, pbm);
+
+    FILE* file = fopen(path, "wb");
+
+    if(file == NULL || fwrite(pbm, 1, sizeof(pbm), file) != sizeof(pbm))
+    {
+        fprintf(stderr, "cannot write %s\n", path);
+    }
+    if(file != NULL)
+    {
+        fclose(file);
+    }
+}
+
+uint64_t model_i2c_time_us(const ssd1306_replay_stats_t* stats, unsigned int freq_khz)
+{
+    // Same model as ssd1306_model_i2c_time_ns, the address byte is not part of the counted bytes
+    uint64_t clocks = (uint64_t)(stats->bytes + stats->transactions) * SSD1306_I2C_CLOCKS_PER_BYTE
+        + (uint64_t)stats->transactions * SSD1306_I2C_TXN_OVERHEAD_CLOCKS;
+
+    return (clocks * 1000000 / freq_khz + (uint64_t)stats->transactions * SSD1306_I2C_TXN_GAP_NS) / 1000;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s LOG [PBM_PREFIX]\n", argv[0]);
+        return 2;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+
+    if(file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long log_len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* log = malloc(log_len > 0 ? log_len : 1);
+
+    if(log == NULL || fread(log, 1, log_len, file) != (size_t)log_len)
+    {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        fclose(file);
+        free(log);
+        return 1;
+    }
+
+    fclose(file);
+
+    ssd1306_replay_sim_t sim;
+    ssd1306_replay_stats_t stats;
+
+    ssd1306_replay_sim_init(&sim);
+
+    bool is_complete = ssd1306_replay_log(log, log_len, &sim, &stats, argc > 2 ? write_frame : NULL, argc > 2 ? argv[2] : NULL);
+
+    printf("{\n");
+    printf("  \"complete\": %s,\n", is_complete ? "true" : "false");
+    printf("  \"transactions\": %lu,\n", (unsigned long)stats.transactions);
+    printf("  \"cmd_transactions\": %lu,\n", (unsigned long)stats.cmd_transactions);
+    printf("  \"data_transactions\": %lu,\n", (unsigned long)stats.data_transactions);
+    printf("  \"bytes\": %lu,\n", (unsigned long)stats.bytes);
+    printf("  \"data_bytes\": %lu,\n", (unsigned long)stats.data_bytes);
+    printf("  \"frames\": %lu,\n", (unsigned long)stats.frames);
+    printf("  \"unknown_cmds\": %lu,\n", (unsigned long)sim.unknown_cmds);
+    printf("  \"duration_us\": %llu,\n", (unsigned long long)stats.duration_us);
+    printf("  \"wire_time_us\": {\n");
+    printf("    \"i2c_400khz\": %llu,\n", (unsigned long long)model_i2c_time_us(&stats, 400));
+    printf("    \"i2c_1mhz\": %llu\n", (unsigned long long)model_i2c_time_us(&stats, 1000));
+    printf("  }\n");
+    printf("}\n");
+
+    free(log);
+
+    return is_complete ? 0 : 1;
+}